@@ -15,6 +15,7 @@
 #include <esp_log.h>
 #include <esp_matter_attribute_bounds.h>
 #include <esp_matter_data_model_priv.h>
+#include <esp_matter_typed_bounds.h>
 
 #include <app-common/zap-generated/ids/Attributes.h>
 
@@ -80,6 +81,11 @@ void add_bounds_cb(cluster_t *cluster)
 
 namespace level_control {
 
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_min_level_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(1, 254);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_options_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 3);
+
 void add_bounds_cb(cluster_t *cluster)
 {
     VerifyOrReturn(cluster != nullptr, ESP_LOGE(TAG, "Cluster is NULL. Add bounds Failed!!"));
@@ -106,8 +112,7 @@ void add_bounds_cb(cluster_t *cluster)
                 break;
             }
             case LevelControl::Attributes::MinLevel::Id: {
-                uint8_t min = 1, max = 254;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_uint8(min), esp_matter_uint8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_min_level_bounds);
                 break;
             }
             case LevelControl::Attributes::MaxLevel::Id: {
@@ -178,8 +183,7 @@ void add_bounds_cb(cluster_t *cluster)
                 break;
             }
             case LevelControl::Attributes::Options::Id: {
-                uint8_t min = 0, max = 3;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_bitmap8(min), esp_matter_bitmap8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_options_bounds);
                 break;
             }
             default:
@@ -193,6 +197,29 @@ void add_bounds_cb(cluster_t *cluster)
 
 namespace color_control {
 
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_hue_saturation_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 254);
+static constexpr esp_matter::attribute::typed_bounds<uint16_t> k_remaining_time_bounds =
+    esp_matter::attribute::make_bounds<uint16_t>(0, 65534);
+static constexpr esp_matter::attribute::typed_bounds<uint16_t> k_color_value_bounds =
+    esp_matter::attribute::make_bounds<uint16_t>(0, 65279);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_drift_compensation_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 4);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_color_mode_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 2);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_options_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 1);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_number_of_primaries_bounds =
+    esp_matter::attribute::make_bounds<uint8_t, true>(0, 6);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_enhanced_color_mode_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 3);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_color_loop_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 1);
+static constexpr esp_matter::attribute::typed_bounds<uint16_t> k_color_capabilities_bounds =
+    esp_matter::attribute::make_bounds<uint16_t>(0, 31);
+static constexpr esp_matter::attribute::typed_bounds<uint16_t> k_start_up_color_temperature_bounds =
+    esp_matter::attribute::make_bounds<uint16_t, true>(0, 65279);
+
 void add_bounds_cb(cluster_t *cluster)
 {
     VerifyOrReturn(cluster != nullptr, ESP_LOGE(TAG, "Cluster is NULL. Add bounds Failed!!"));
@@ -203,13 +230,11 @@ void add_bounds_cb(cluster_t *cluster)
 
             case ColorControl::Attributes::CurrentHue::Id:
             case ColorControl::Attributes::CurrentSaturation::Id: {
-                uint8_t min = 0, max = 254;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_uint8(min), esp_matter_uint8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_hue_saturation_bounds);
                 break;
             }
             case ColorControl::Attributes::RemainingTime::Id: {
-                uint16_t min = 0, max = 65534;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_uint16(min), esp_matter_uint16(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_remaining_time_bounds);
                 break;
             }
             case ColorControl::Attributes::CurrentX::Id:
@@ -237,49 +262,40 @@ void add_bounds_cb(cluster_t *cluster)
             case ColorControl::Attributes::ColorPointBY::Id:
             case ColorControl::Attributes::ColorTempPhysicalMinMireds::Id:
             case ColorControl::Attributes::ColorTempPhysicalMaxMireds::Id: {
-                uint16_t min = 0, max = 65279;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_uint16(min), esp_matter_uint16(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_color_value_bounds);
                 break;
             }
             case ColorControl::Attributes::DriftCompensation::Id: {
-                uint8_t min = 0, max = 4;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_drift_compensation_bounds);
                 break;
             }
             case ColorControl::Attributes::ColorMode::Id: {
-                uint8_t min = 0, max = 2;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_color_mode_bounds);
                 break;
             }
             case ColorControl::Attributes::Options::Id: {
-                uint8_t min = 0, max = 1;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_bitmap8(min), esp_matter_bitmap8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_options_bounds);
                 break;
             }
             case ColorControl::Attributes::NumberOfPrimaries::Id: {
-                uint8_t min = 0, max = 6;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_nullable_uint8(min), esp_matter_nullable_uint8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_number_of_primaries_bounds);
                 break;
             }
             case ColorControl::Attributes::EnhancedColorMode::Id: {
-                uint8_t min = 0, max = 3;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_enhanced_color_mode_bounds);
                 break;
             }
             case ColorControl::Attributes::ColorLoopActive::Id:
             case ColorControl::Attributes::ColorLoopDirection::Id: {
-                uint8_t min = 0, max = 1;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_uint8(min), esp_matter_uint8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_color_loop_bounds);
                 break;
             }
             case ColorControl::Attributes::ColorCapabilities::Id: {
-                uint8_t min = 0, max = 31;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_bitmap16(min), esp_matter_bitmap16(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_color_capabilities_bounds);
                 break;
             }
             case ColorControl::Attributes::StartUpColorTemperatureMireds::Id: {
-                uint16_t min = 0, max = 65279;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_nullable_uint16(min), esp_matter_nullable_uint16(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_start_up_color_temperature_bounds);
                 break;
             }
             case ColorControl::Attributes::CoupleColorTempToLevelMinMireds::Id: {
@@ -381,6 +397,29 @@ void add_bounds_cb(cluster_t *cluster)
 
 namespace thermostat {
 
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_pi_demand_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 100);
+static constexpr esp_matter::attribute::typed_bounds<int16_t> k_min_setpoint_dead_band_bounds =
+    esp_matter::attribute::make_bounds<int16_t>(0, 1270);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_control_sequence_of_operation_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 5);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_system_mode_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 9);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_running_mode_ac_type_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 4);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_start_of_week_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 6);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_temperature_setpoint_hold_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 1);
+static constexpr esp_matter::attribute::typed_bounds<uint16_t> k_temperature_setpoint_hold_duration_bounds =
+    esp_matter::attribute::make_bounds<uint16_t, true>(0, 1440);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_setpoint_change_source_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 2);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_ac_refrigerant_compressor_type_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(0, 3);
+static constexpr esp_matter::attribute::typed_bounds<uint8_t> k_ac_louver_position_bounds =
+    esp_matter::attribute::make_bounds<uint8_t>(1, 5);
+
 void add_bounds_cb(cluster_t *cluster)
 {
     VerifyOrReturn(cluster != nullptr, ESP_LOGE(TAG, "Cluster is NULL. Add bounds Failed!!"));
@@ -391,8 +430,7 @@ void add_bounds_cb(cluster_t *cluster)
 
             case Thermostat::Attributes::PICoolingDemand::Id:
             case Thermostat::Attributes::PIHeatingDemand::Id: {
-                uint8_t min = 0, max = 100;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_uint8(min), esp_matter_uint8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_pi_demand_bounds);
                 break;
             }
             case Thermostat::Attributes::OccupiedCoolingSetpoint::Id:
@@ -500,45 +538,37 @@ void add_bounds_cb(cluster_t *cluster)
                 break;
             }
             case Thermostat::Attributes::MinSetpointDeadBand::Id: {
-                int16_t min = 0, max = 1270;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_int16(min), esp_matter_int16(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_min_setpoint_dead_band_bounds);
                 break;
             }
             case Thermostat::Attributes::ControlSequenceOfOperation::Id: {
-                uint8_t min = 0, max = 5;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_control_sequence_of_operation_bounds);
                 break;
             }
             case Thermostat::Attributes::SystemMode::Id: {
-                uint8_t min = 0, max = 9;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_system_mode_bounds);
                 break;
             }
             case Thermostat::Attributes::ThermostatRunningMode::Id:
             case Thermostat::Attributes::ACType::Id: {
                 // TODO: The valid values for ThermostatRunningMode are: 0, 3, 4. But there is no way to set the bounds for it.
-                uint8_t min = 0, max = 4;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_running_mode_ac_type_bounds);
                 break;
             }
             case Thermostat::Attributes::StartOfWeek::Id: {
-                uint8_t min = 0, max = 6;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_start_of_week_bounds);
                 break;
             }
             case Thermostat::Attributes::TemperatureSetpointHold::Id: {
-                uint8_t min = 0, max = 1;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_temperature_setpoint_hold_bounds);
                 break;
             }
             case Thermostat::Attributes::TemperatureSetpointHoldDuration::Id: {
-                nullable<uint16_t> min = 0, max = 1440;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_nullable_uint16(min), esp_matter_nullable_uint16(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_temperature_setpoint_hold_duration_bounds);
                 break;
             }
             case Thermostat::Attributes::SetpointChangeSource::Id: {
-                uint8_t min = 0, max = 2;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_setpoint_change_source_bounds);
                 break;
             }
             case Thermostat::Attributes::OccupiedSetback::Id: {
@@ -621,13 +651,11 @@ void add_bounds_cb(cluster_t *cluster)
             }
             case Thermostat::Attributes::ACRefrigerantType::Id:
             case Thermostat::Attributes::ACCompressorType::Id: {
-                uint8_t min = 0, max = 3;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_ac_refrigerant_compressor_type_bounds);
                 break;
             }
             case Thermostat::Attributes::ACLouverPosition::Id: {
-                uint8_t min = 1, max = 5;
-                esp_matter::attribute::add_bounds(current_attribute, esp_matter_enum8(min), esp_matter_enum8(max));
+                esp_matter::attribute::set_shared_bounds(current_attribute, &k_ac_louver_position_bounds);
                 break;
             }
             default:
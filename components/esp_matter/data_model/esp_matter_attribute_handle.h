@@ -0,0 +1,297 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <esp_matter_data_model.h>
+#include <initializer_list>
+#include <stdint.h>
+#include <type_traits>
+
+#include <app/data-model/Nullable.h>
+#include <app/util/attribute-storage-null-handling.h>
+#include <lib/support/BitMask.h>
+#include <lib/support/CodeUtils.h>
+
+/** Typed attribute handles
+ *
+ * A handle is resolved once from the attribute path and the value type of the attribute is checked at that time.
+ * After that, `get()` reads the value from the esp-matter storage and `set()` and `update()` write it, without the
+ * path lookup and without filling an `esp_matter_attr_val_t` by hand.
+ *
+ * The handle type is the C type of the value: `uint8_t` for the uint8, enum8 and bitmap8 attributes, `uint16_t` for
+ * the uint16, enum16 and bitmap16 attributes, and so on, wrapped in `nullable<>` for the nullable attributes. When the
+ * attribute is given by its zap-generated `TypeInfo`, the handle type is checked at compile time.
+ *
+ * Example:
+ *
+ *     using namespace chip::app::Clusters;
+ *     attribute::handle<uint8_t> current_level;
+ *     current_level.resolve<LevelControl::Attributes::CurrentLevel::TypeInfo>(endpoint_id);
+ *     uint8_t level = current_level.get();
+ *     current_level.update(level + 1);
+ *
+ * The handles only work for the attributes whose value is kept by the esp-matter data model, the attributes managed
+ * by the connectedhomeip clusters cannot be resolved. A handle must not be used after its attribute, cluster or
+ * endpoint is destroyed.
+ */
+
+namespace esp_matter {
+namespace attribute {
+
+namespace detail {
+
+/** Value traits of the C types which can be used with a handle */
+template <typename T>
+struct handle_traits {
+    static constexpr bool k_supported = false;
+};
+
+#define ESP_MATTER_HANDLE_TRAITS(c_type, member, ...)                                                                \
+    template <>                                                                                                      \
+    struct handle_traits<c_type> {                                                                                   \
+        static constexpr bool k_supported = true;                                                                    \
+        static bool matches(esp_matter_val_type_t type)                                                              \
+        {                                                                                                            \
+            for (esp_matter_val_type_t supported : {__VA_ARGS__}) {                                                  \
+                if (type == supported) {                                                                             \
+                    return true;                                                                                     \
+                }                                                                                                    \
+            }                                                                                                        \
+            return false;                                                                                            \
+        }                                                                                                            \
+        static c_type load(const esp_matter_val_t &val)                                                              \
+        {                                                                                                            \
+            return val.member;                                                                                       \
+        }                                                                                                            \
+        static void store(esp_matter_val_t &val, c_type value)                                                       \
+        {                                                                                                            \
+            val.member = value;                                                                                      \
+        }                                                                                                            \
+        static bool equals(const esp_matter_val_t &val, c_type value)                                                \
+        {                                                                                                            \
+            return val.member == value;                                                                              \
+        }                                                                                                            \
+    };
+
+ESP_MATTER_HANDLE_TRAITS(bool, b, ESP_MATTER_VAL_TYPE_BOOLEAN)
+ESP_MATTER_HANDLE_TRAITS(float, f, ESP_MATTER_VAL_TYPE_FLOAT)
+ESP_MATTER_HANDLE_TRAITS(int8_t, i8, ESP_MATTER_VAL_TYPE_INT8)
+ESP_MATTER_HANDLE_TRAITS(int16_t, i16, ESP_MATTER_VAL_TYPE_INT16)
+ESP_MATTER_HANDLE_TRAITS(int32_t, i32, ESP_MATTER_VAL_TYPE_INT32)
+ESP_MATTER_HANDLE_TRAITS(int64_t, i64, ESP_MATTER_VAL_TYPE_INT64)
+ESP_MATTER_HANDLE_TRAITS(uint8_t, u8, ESP_MATTER_VAL_TYPE_UINT8, ESP_MATTER_VAL_TYPE_ENUM8, ESP_MATTER_VAL_TYPE_BITMAP8)
+ESP_MATTER_HANDLE_TRAITS(uint16_t, u16, ESP_MATTER_VAL_TYPE_UINT16, ESP_MATTER_VAL_TYPE_ENUM16,
+                         ESP_MATTER_VAL_TYPE_BITMAP16)
+ESP_MATTER_HANDLE_TRAITS(uint32_t, u32, ESP_MATTER_VAL_TYPE_UINT32, ESP_MATTER_VAL_TYPE_BITMAP32)
+ESP_MATTER_HANDLE_TRAITS(uint64_t, u64, ESP_MATTER_VAL_TYPE_UINT64)
+
+#undef ESP_MATTER_HANDLE_TRAITS
+
+/* The nullable values are stored with the null value of connectedhomeip, in the member of the non nullable type */
+template <typename T>
+struct handle_traits<nullable<T>> {
+    static constexpr bool k_supported = handle_traits<T>::k_supported;
+    static bool matches(esp_matter_val_type_t type)
+    {
+        return (type & ESP_MATTER_VAL_NULLABLE_BASE) &&
+            handle_traits<T>::matches((esp_matter_val_type_t)(type & ~ESP_MATTER_VAL_NULLABLE_BASE));
+    }
+    static nullable<T> load(const esp_matter_val_t &val)
+    {
+        return nullable<T>(handle_traits<T>::load(val));
+    }
+    static void store(esp_matter_val_t &val, nullable<T> value)
+    {
+        // value() returns the null value of T when the value is null
+        handle_traits<T>::store(val, value.value());
+    }
+    static bool equals(const esp_matter_val_t &val, nullable<T> value)
+    {
+        return !value.is_null() && handle_traits<T>::equals(val, value.value());
+    }
+};
+
+/* The null boolean is 0xFF, which is not a valid bool, so it is read and written as a byte */
+template <>
+struct handle_traits<nullable<bool>> {
+    static constexpr bool k_supported = true;
+    static bool matches(esp_matter_val_type_t type)
+    {
+        return type == ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN;
+    }
+    static nullable<bool> load(const esp_matter_val_t &val)
+    {
+        if (chip::app::NumericAttributeTraits<bool>::IsNullValue(val.u8)) {
+            return nullable<bool>();
+        }
+        return nullable<bool>(val.u8 != 0);
+    }
+    static void store(esp_matter_val_t &val, nullable<bool> value)
+    {
+        if (value.is_null()) {
+            chip::app::NumericAttributeTraits<bool>::SetNull(val.u8);
+        } else {
+            val.u8 = value.value() ? 1 : 0;
+        }
+    }
+    static bool equals(const esp_matter_val_t &val, nullable<bool> value)
+    {
+        return !value.is_null() && val.u8 == (value.value() ? 1 : 0);
+    }
+};
+
+/** Handle type of a zap-generated attribute type */
+template <typename Type, typename Enable = void>
+struct handle_type {
+    using type = Type;
+};
+
+template <typename Type>
+struct handle_type<Type, std::enable_if_t<std::is_enum<Type>::value>> {
+    using type = std::underlying_type_t<Type>;
+};
+
+template <typename FlagsEnum, typename StorageType>
+struct handle_type<chip::BitMask<FlagsEnum, StorageType>> {
+    using type = StorageType;
+};
+
+template <typename Type>
+struct handle_type<chip::app::DataModel::Nullable<Type>> {
+    using type = nullable<typename handle_type<Type>::type>;
+};
+
+/** Resolved attribute of a handle */
+typedef struct handle_base {
+    attribute_t *attribute;
+    /* Value in the esp-matter storage */
+    esp_matter_val_t *val;
+    esp_matter_val_type_t type;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+} handle_base_t;
+
+/** Resolve an attribute path for a handle, matches checks the value type of the attribute */
+esp_err_t resolve_handle(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                         bool (*matches)(esp_matter_val_type_t type), handle_base_t *base);
+
+/** Set the value of a resolved attribute, as `attribute::set_val()` does */
+esp_err_t set_handle_val(const handle_base_t &base, const esp_matter_val_t &val, bool call_callbacks);
+
+/** Update the value of a resolved attribute, as `attribute::update()` does */
+esp_err_t update_handle_val(const handle_base_t &base, const esp_matter_val_t &val);
+
+} // namespace detail
+
+/** Handle type of a zap-generated attribute, for example
+ *  `handle_for<OnOff::Attributes::OnOff::TypeInfo>` is `handle<bool>`
+ */
+template <typename T>
+class handle;
+
+template <typename TypeInfo>
+using handle_for = handle<typename detail::handle_type<typename TypeInfo::Type>::type>;
+
+template <typename T>
+class handle {
+    static_assert(detail::handle_traits<T>::k_supported,
+                  "Only the boolean, integer, float, enum and bitmap attributes can be used with a handle");
+    using traits = detail::handle_traits<T>;
+
+public:
+    handle() : m_base{} {}
+
+    /** Resolve the handle from an attribute path
+     *
+     * @param[in] endpoint_id Endpoint id.
+     * @param[in] cluster_id Cluster id.
+     * @param[in] attribute_id Attribute id.
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FOUND if the attribute does not exist.
+     * @return ESP_ERR_NOT_SUPPORTED if the value of the attribute is not kept by the esp-matter data model.
+     * @return ESP_ERR_INVALID_ARG if the value type of the attribute does not match T.
+     */
+    esp_err_t resolve(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+    {
+        return detail::resolve_handle(endpoint_id, cluster_id, attribute_id, traits::matches, &m_base);
+    }
+
+    /** Resolve the handle from a zap-generated attribute, T must be the C type of the attribute
+     *
+     * @param[in] endpoint_id Endpoint id.
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure, see `resolve()`.
+     */
+    template <typename TypeInfo>
+    esp_err_t resolve(uint16_t endpoint_id)
+    {
+        static_assert(std::is_same<T, typename detail::handle_type<typename TypeInfo::Type>::type>::value,
+                      "The handle type does not match the type of the attribute");
+        return resolve(endpoint_id, TypeInfo::GetClusterId(), TypeInfo::GetAttributeId());
+    }
+
+    /** Whether the handle was resolved */
+    bool is_valid() const { return m_base.attribute != nullptr; }
+
+    /** Attribute handle, NULL if the handle is not resolved */
+    attribute_t *get_attribute() const { return m_base.attribute; }
+
+    /** Get the attribute value, the handle must be resolved */
+    T get() const { return traits::load(*m_base.val); }
+
+    /** Set the attribute value, as `attribute::set_val()` does
+     *
+     * @param[in] value New value.
+     * @param[in] call_callbacks Whether to call attribute change pre/post callbacks.
+     *
+     * @return ESP_OK on success.
+     * @return ESP_ERR_NOT_FINISHED if the value is not changed.
+     * @return error in case of failure.
+     */
+    esp_err_t set(T value, bool call_callbacks = true)
+    {
+        VerifyOrReturnError(is_valid(), ESP_ERR_INVALID_STATE);
+        VerifyOrReturnError(!traits::equals(*m_base.val, value), ESP_ERR_NOT_FINISHED);
+        esp_matter_val_t val = {};
+        traits::store(val, value);
+        return detail::set_handle_val(m_base, val, call_callbacks);
+    }
+
+    /** Update the attribute value and report it, as `attribute::update()` does
+     *
+     * @param[in] value New value.
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure.
+     */
+    esp_err_t update(T value)
+    {
+        VerifyOrReturnError(is_valid(), ESP_ERR_INVALID_STATE);
+        esp_matter_val_t val = {};
+        traits::store(val, value);
+        return detail::update_handle_val(m_base, val);
+    }
+
+private:
+    detail::handle_base_t m_base;
+};
+
+} // namespace attribute
+} // namespace esp_matter
@@ -0,0 +1,263 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <esp_log.h>
+#include <esp_matter_attribute_queue.h>
+#include <esp_matter_core.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+#include <inttypes.h>
+#include <lib/support/CodeUtils.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <sdkconfig.h>
+
+static const char *TAG = "esp_matter_attribute_queue";
+
+namespace esp_matter {
+namespace attribute_queue {
+
+#if CONFIG_ESP_MATTER_ATTRIBUTE_QUEUE_SIZE > 0
+
+static constexpr uint32_t round_up_to_power_of_two(uint32_t value)
+{
+    // The ring needs at least two cells to tell a full cell from an empty one
+    uint32_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+static constexpr uint32_t k_capacity = round_up_to_power_of_two(CONFIG_ESP_MATTER_ATTRIBUTE_QUEUE_SIZE);
+static constexpr uint32_t k_mask = k_capacity - 1;
+// Number of values taken out of the queue before applying them, the newest value of an attribute in a batch wins
+static constexpr uint32_t k_drain_batch_size = k_capacity < 16 ? k_capacity : 16;
+// Delay before posting the drain again when the Matter event queue was full
+static constexpr uint32_t k_schedule_retry_ms = 20;
+
+typedef struct record {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    esp_matter_attr_val_t val;
+} record_t;
+
+/* The queue is a bounded ring where each cell has a sequence number, so that the producers reserve a cell with one
+ * compare-and-swap and the consumer knows when the record of a cell is completely written. The sequence is stored
+ * relative to the cell index, so that the zero-initialized cells are ready for the first round. */
+typedef struct cell {
+    std::atomic<uint32_t> sequence;
+    record_t record;
+} cell_t;
+
+static cell_t cells[k_capacity];
+static std::atomic<uint32_t> enqueue_position{0};
+static std::atomic<uint32_t> dequeue_position{0};
+static std::atomic<bool> drain_scheduled{false};
+static record_t drain_records[k_drain_batch_size];
+
+static std::atomic<uint32_t> pushed_count{0};
+static std::atomic<uint32_t> applied_count{0};
+static std::atomic<uint32_t> coalesced_count{0};
+static std::atomic<uint32_t> overflow_count{0};
+static std::atomic<uint32_t> schedule_failure_count{0};
+static std::atomic<uint32_t> high_water_mark{0};
+
+static bool pop(record_t *record)
+{
+    // Only the Matter thread takes records out of the queue
+    uint32_t position = dequeue_position.load(std::memory_order_relaxed);
+    cell_t &cell = cells[position & k_mask];
+    uint32_t sequence = cell.sequence.load(std::memory_order_acquire) + (position & k_mask);
+    if (sequence != position + 1) {
+        return false;
+    }
+    *record = cell.record;
+    cell.sequence.store(position + k_capacity - (position & k_mask), std::memory_order_release);
+    dequeue_position.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+static bool is_same_path(const record_t &a, const record_t &b)
+{
+    return a.endpoint_id == b.endpoint_id && a.cluster_id == b.cluster_id && a.attribute_id == b.attribute_id;
+}
+
+static void apply(record_t *records, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        bool replaced = false;
+        for (uint32_t j = i + 1; j < count && !replaced; ++j) {
+            replaced = is_same_path(records[i], records[j]);
+        }
+        if (replaced) {
+            coalesced_count.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        esp_err_t err = attribute::update(records[i].endpoint_id, records[i].cluster_id, records[i].attribute_id,
+                                          &records[i].val);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to update Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32
+                     ": %s", records[i].endpoint_id, records[i].cluster_id, records[i].attribute_id,
+                     esp_err_to_name(err));
+        }
+        applied_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void drain(intptr_t arg)
+{
+    // Clear the flag first, so that the values pushed while draining schedule another drain
+    drain_scheduled.store(false, std::memory_order_release);
+    uint32_t count;
+    do {
+        count = 0;
+        while (count < k_drain_batch_size && pop(&drain_records[count])) {
+            count++;
+        }
+        apply(drain_records, count);
+    } while (count == k_drain_batch_size);
+}
+
+static void schedule_drain();
+
+static void schedule_retry(TimerHandle_t timer)
+{
+    schedule_drain();
+}
+
+static TimerHandle_t get_retry_timer()
+{
+    static StaticTimer_t s_retry_timer_storage;
+    static TimerHandle_t s_retry_timer = xTimerCreateStatic("attr_queue_retry", pdMS_TO_TICKS(k_schedule_retry_ms),
+                                                            pdFALSE, nullptr, schedule_retry, &s_retry_timer_storage);
+    return s_retry_timer;
+}
+
+// drain_scheduled is set while the drain is posted or waiting to be posted again, so that the pushes do not post it
+static void schedule_drain()
+{
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(drain, 0) == CHIP_NO_ERROR) {
+        return;
+    }
+    // The Matter event queue is full, the drain is posted again from the timer task so that the queued values do not
+    // wait for another push
+    schedule_failure_count.fetch_add(1, std::memory_order_relaxed);
+    if (xTimerStart(get_retry_timer(), 0) != pdPASS) {
+        // The next push posts it again
+        drain_scheduled.store(false, std::memory_order_release);
+    }
+}
+
+static void update_high_water_mark(uint32_t depth)
+{
+    uint32_t current = high_water_mark.load(std::memory_order_relaxed);
+    while (depth > current &&
+           !high_water_mark.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+    }
+}
+
+esp_err_t push(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val)
+{
+    VerifyOrReturnError(val, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "val cannot be NULL"));
+    VerifyOrReturnError(val->type != ESP_MATTER_VAL_TYPE_CHAR_STRING &&
+                            val->type != ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING &&
+                            val->type != ESP_MATTER_VAL_TYPE_OCTET_STRING &&
+                            val->type != ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING &&
+                            val->type != ESP_MATTER_VAL_TYPE_ARRAY,
+                        ESP_ERR_NOT_SUPPORTED, ESP_LOGE(TAG, "String and array values cannot be queued"));
+    VerifyOrReturnError(esp_matter::is_started(), ESP_ERR_INVALID_STATE,
+                        ESP_LOGE(TAG, "esp_matter::start() should be called before queueing attribute values"));
+
+    /* Reserve a cell */
+    uint32_t position = enqueue_position.load(std::memory_order_relaxed);
+    cell_t *cell;
+    while (true) {
+        cell = &cells[position & k_mask];
+        uint32_t sequence = cell->sequence.load(std::memory_order_acquire) + (position & k_mask);
+        int32_t diff = (int32_t)(sequence - position);
+        if (diff == 0) {
+            if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            overflow_count.fetch_add(1, std::memory_order_relaxed);
+            return ESP_ERR_NO_MEM;
+        } else {
+            position = enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    /* Write the record and publish it */
+    cell->record.endpoint_id = endpoint_id;
+    cell->record.cluster_id = cluster_id;
+    cell->record.attribute_id = attribute_id;
+    cell->record.val = *val;
+    cell->sequence.store(position + 1 - (position & k_mask), std::memory_order_release);
+
+    pushed_count.fetch_add(1, std::memory_order_relaxed);
+    update_high_water_mark(position + 1 - dequeue_position.load(std::memory_order_relaxed));
+    if (!drain_scheduled.exchange(true, std::memory_order_acq_rel)) {
+        schedule_drain();
+    }
+    return ESP_OK;
+}
+
+esp_err_t get_stats(stats_t *stats)
+{
+    VerifyOrReturnError(stats, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "stats cannot be NULL"));
+    stats->pushed = pushed_count.load(std::memory_order_relaxed);
+    stats->applied = applied_count.load(std::memory_order_relaxed);
+    stats->coalesced = coalesced_count.load(std::memory_order_relaxed);
+    stats->overflows = overflow_count.load(std::memory_order_relaxed);
+    stats->schedule_failures = schedule_failure_count.load(std::memory_order_relaxed);
+    stats->high_water_mark = (uint16_t)high_water_mark.load(std::memory_order_relaxed);
+    stats->capacity = (uint16_t)k_capacity;
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    pushed_count.store(0, std::memory_order_relaxed);
+    applied_count.store(0, std::memory_order_relaxed);
+    coalesced_count.store(0, std::memory_order_relaxed);
+    overflow_count.store(0, std::memory_order_relaxed);
+    schedule_failure_count.store(0, std::memory_order_relaxed);
+    high_water_mark.store(0, std::memory_order_relaxed);
+}
+
+#else // CONFIG_ESP_MATTER_ATTRIBUTE_QUEUE_SIZE > 0
+
+esp_err_t push(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val)
+{
+    ESP_LOGE(TAG, "The attribute queue is disabled, set CONFIG_ESP_MATTER_ATTRIBUTE_QUEUE_SIZE to enable it");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t get_stats(stats_t *stats)
+{
+    VerifyOrReturnError(stats, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "stats cannot be NULL"));
+    *stats = {};
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+}
+
+#endif // CONFIG_ESP_MATTER_ATTRIBUTE_QUEUE_SIZE > 0
+
+} // namespace attribute_queue
+} // namespace esp_matter
@@ -0,0 +1,97 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <stdint.h>
+
+/** Attribute update queue
+ *
+ * The application tasks push attribute values into a bounded queue without taking the Matter stack lock. The Matter
+ * thread drains the queue and updates the attributes as `attribute::update()` does. When several values are queued
+ * for the same attribute, only the newest one is applied.
+ *
+ * The queue size is set by `CONFIG_ESP_MATTER_ATTRIBUTE_QUEUE_SIZE`, the queue is disabled if it is 0.
+ */
+
+namespace esp_matter {
+namespace attribute_queue {
+
+/** Attribute update queue statistics */
+typedef struct stats {
+    /** Number of values pushed into the queue */
+    uint32_t pushed;
+    /** Number of values applied by the Matter thread */
+    uint32_t applied;
+    /** Number of values replaced by a newer value of the same attribute before being applied */
+    uint32_t coalesced;
+    /** Number of values dropped because the queue was full */
+    uint32_t overflows;
+    /** Number of times the drain could not be posted to the Matter event queue */
+    uint32_t schedule_failures;
+    /** Largest number of values which were in the queue at the same time */
+    uint16_t high_water_mark;
+    /** Queue capacity */
+    uint16_t capacity;
+} stats_t;
+
+/** Push an attribute value into the queue
+ *
+ * This does not take the Matter stack lock and does not block. The value is applied later in the Matter thread with
+ * the `PRE_UPDATE` and `POST_UPDATE` callbacks. It must not be called before `esp_matter::start()`.
+ *
+ * Supported contexts:
+ * - Any task, including the Matter thread.
+ * - The tasks to which interrupts defer their work, such as a task woken by `vTaskNotifyGiveFromISR()`, the FreeRTOS
+ *   timer service task through `xTimerPendFunctionCallFromISR()`, or `esp_timer` callbacks with `ESP_TIMER_TASK`
+ *   dispatch.
+ *
+ * It must not be called from an ISR, including `esp_timer` callbacks with `ESP_TIMER_ISR` dispatch: posting the drain
+ * to the Matter event queue is not ISR-safe.
+ *
+ * If the drain cannot be posted because the Matter event queue is full, the value stays queued and the drain is
+ * posted again from the FreeRTOS timer service task a little later. This is counted in `stats_t::schedule_failures`.
+ *
+ * Only the value types which fit in `esp_matter_val_t` are supported, the string and array values are not copied
+ * and should be updated with `attribute::update()`.
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if the queue is full, the value is dropped.
+ * @return ESP_ERR_NOT_SUPPORTED if the queue is disabled or the value type is a string or array.
+ * @return ESP_ERR_INVALID_STATE if esp-matter is not started.
+ * @return error in case of failure.
+ */
+esp_err_t push(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val);
+
+/** Get the attribute update queue statistics
+ *
+ * @param[out] stats Queue statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_stats(stats_t *stats);
+
+/** Reset the counters and the high water mark of the attribute update queue */
+void reset_stats();
+
+} // namespace attribute_queue
+} // namespace esp_matter
@@ -17,6 +17,7 @@
 #include "esp_matter_data_model.h"
 #include "app/AttributePathParams.h"
 #include "data_model_provider/esp_matter_data_model_provider.h"
+#include <algorithm>
 #include <cstdint>
 #include <esp_log.h>
 #include <esp_matter.h>
@@ -25,6 +26,8 @@
 #include <esp_matter_core.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_data_model_priv.h>
+#include <esp_matter_nvs.h>
+#include <esp_matter_report_policy.h>
 #include <string.h>
 
 #include <app/util/attribute-storage.h>
@@ -630,22 +633,35 @@ void val_print(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
     }
 }
 
-esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+// A change held back by the reporting policy still changes the data version, only its report waits
+static void increase_data_version(uint16_t endpoint_id, uint32_t cluster_id)
 {
-    VerifyOrReturnError(val, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "val cannot be NULL"));
-    attribute_t *attr = get(endpoint_id, cluster_id, attribute_id);
-    ESP_RETURN_ON_FALSE(attr, ESP_ERR_INVALID_ARG, TAG, "Failed to get attribute handle");
+    cluster_t *cluster = cluster::get(endpoint_id, cluster_id);
+    if (cluster) {
+        cluster::increase_data_version(cluster);
+    }
+}
 
+esp_err_t update_internal(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                          esp_matter_attr_val_t *val, bool apply_report_policy)
+{
     /* Take lock if not already taken */
     lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
     VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
     /* Here, the val_print function gets called on attribute write.*/
     attribute::val_print(endpoint_id, cluster_id, attribute_id, val, false);
 
-    esp_err_t err = attribute::set_val_internal(attr, val);
+    esp_err_t err = attribute::set_val_internal(attribute, val);
     if (err == ESP_OK) {
-        data_model::provider::get_instance().Temporary_ReportAttributeChanged(
-            chip::app::AttributePathParams(endpoint_id, cluster_id, attribute_id));
+        if (!apply_report_policy) {
+            report_policy::mark_reported(attribute, val);
+        }
+        if (!apply_report_policy || report_policy::should_report(attribute, val)) {
+            data_model::provider::get_instance().Temporary_ReportAttributeChanged(
+                chip::app::AttributePathParams(endpoint_id, cluster_id, attribute_id));
+        } else {
+            increase_data_version(endpoint_id, cluster_id);
+        }
     } else if (err == ESP_ERR_NOT_FINISHED) {
         err = ESP_OK;
     }
@@ -655,6 +671,102 @@ esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
     return err;
 }
 
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    VerifyOrReturnError(val, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "val cannot be NULL"));
+    attribute_t *attr = get(endpoint_id, cluster_id, attribute_id);
+    ESP_RETURN_ON_FALSE(attr, ESP_ERR_INVALID_ARG, TAG, "Failed to get attribute handle");
+    return update_internal(attr, endpoint_id, cluster_id, attribute_id, val);
+}
+
+namespace detail {
+
+esp_err_t update_handle_val(const handle_base_t &base, const esp_matter_val_t &val)
+{
+    esp_matter_attr_val_t attr_val = {base.type, val};
+    return update_internal(base.attribute, base.endpoint_id, base.cluster_id, base.attribute_id, &attr_val);
+}
+
+} // namespace detail
+
+esp_err_t update_batch(const path_value_t *items, size_t count)
+{
+    VerifyOrReturnError(items || count == 0, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "items cannot be NULL"));
+    VerifyOrReturnValue(count > 0, ESP_OK);
+
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
+
+    /* Look the attributes up once and check all the values before calling any callback */
+    attribute_t **attrs = (attribute_t **)esp_matter_mem_calloc(count, sizeof(attribute_t *));
+    esp_err_t err = attrs ? ESP_OK : ESP_ERR_NO_MEM;
+    for (size_t i = 0; i < count && err == ESP_OK; ++i) {
+        attrs[i] = get(items[i].endpoint_id, items[i].cluster_id, items[i].attribute_id);
+        err = attrs[i] ? attribute::check_val_internal(attrs[i], &items[i].val) : ESP_ERR_INVALID_ARG;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Cannot update Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32
+                     ": %s", items[i].endpoint_id, items[i].cluster_id, items[i].attribute_id, esp_err_to_name(err));
+        }
+    }
+
+    /* Call all the PRE_UPDATE callbacks before updating any attribute, so that a rejected value updates none. The
+       attributes whose value does not change are dropped. */
+    for (size_t i = 0; i < count && err == ESP_OK; ++i) {
+        esp_matter_attr_val_t val = items[i].val;
+        err = attribute::pre_update_internal(attrs[i], &val);
+        if (err == ESP_ERR_NOT_FINISHED) {
+            attrs[i] = nullptr;
+            err = ESP_OK;
+        }
+    }
+
+    if (err == ESP_OK) {
+        bool nvs_batch = attribute::begin_nvs_batch() == ESP_OK;
+        // The changed attributes are marked as dirty after each group of updates
+        constexpr size_t k_group_size = 32;
+        for (size_t group = 0; group < count; group += k_group_size) {
+            size_t group_count = std::min(count - group, k_group_size);
+            uint32_t changed = 0;
+            for (size_t i = 0; i < group_count; ++i) {
+                const path_value_t &item = items[group + i];
+                attribute_t *attr = attrs[group + i];
+                if (!attr) {
+                    continue;
+                }
+                esp_matter_attr_val_t val = item.val;
+                attribute::val_print(item.endpoint_id, item.cluster_id, item.attribute_id, &val, false);
+                esp_err_t item_err = attribute::set_prepared_val_internal(attr, &val);
+                if (item_err == ESP_OK) {
+                    if (report_policy::should_report(attr, &val)) {
+                        changed |= 1UL << i;
+                    } else {
+                        increase_data_version(item.endpoint_id, item.cluster_id);
+                    }
+                } else if (err == ESP_OK) {
+                    err = item_err;
+                }
+            }
+            for (size_t i = 0; i < group_count; ++i) {
+                if (changed & (1UL << i)) {
+                    const path_value_t &item = items[group + i];
+                    data_model::provider::get_instance().Temporary_ReportAttributeChanged(
+                        chip::app::AttributePathParams(item.endpoint_id, item.cluster_id, item.attribute_id));
+                }
+            }
+        }
+        if (nvs_batch) {
+            attribute::end_nvs_batch();
+        }
+    }
+    esp_matter_mem_free(attrs);
+
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
 esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
 {
     VerifyOrReturnError(val, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "val cannot be NULL"));
@@ -670,8 +782,12 @@ esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
 
     esp_err_t err = attribute::set_val_internal(attr, val, false);
     if (err == ESP_OK) {
-        /* Report attribute */
-        MatterReportingAttributeChangeCallback(endpoint_id, cluster_id, attribute_id);
+        if (report_policy::should_report(attr, val)) {
+            /* Report attribute */
+            MatterReportingAttributeChangeCallback(endpoint_id, cluster_id, attribute_id);
+        } else {
+            increase_data_version(endpoint_id, cluster_id);
+        }
     } else if (err == ESP_ERR_NOT_FINISHED) {
         err = ESP_OK;
     }
@@ -123,6 +123,8 @@ typedef union {
         uint16_t max;
         /** Total size */
         uint16_t t;
+        /** Buffer capacity, only used by the attribute storage */
+        uint16_t cap;
     } a;
     /** Pointer */
     void *p;
@@ -407,6 +409,38 @@ esp_err_t set_callback(callback_t callback);
  */
 esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
 
+/** Attribute path and value */
+typedef struct path_value {
+    /** Endpoint ID of the attribute */
+    uint16_t endpoint_id;
+    /** Cluster ID of the attribute */
+    uint32_t cluster_id;
+    /** Attribute ID of the attribute */
+    uint32_t attribute_id;
+    /** Value of the attribute */
+    esp_matter_attr_val_t val;
+} path_value_t;
+
+/** Attribute batch update
+ *
+ * This API updates the values of several attributes, like the attributes of a light which change together.
+ * It takes the Matter stack lock once and checks all the values before updating any of them. The `PRE_UPDATE`
+ * callbacks of all the changed attributes are then called in order, and if a value is invalid or one of these
+ * callbacks returns an error, none of the attributes is updated. The callbacks of the items before it have already
+ * been called in that case. The attributes are then updated in order with the `POST_UPDATE` callbacks, as with
+ * `attribute::update()`. The non-volatile values are committed to NVS together and the changed attributes are marked
+ * as dirty once all the values are updated.
+ *
+ * Each attribute should appear once in the batch, the values are compared with the values before the batch.
+ *
+ * @param[in] items Array of attribute paths and values.
+ * @param[in] count Number of items in the array.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t update_batch(const path_value_t *items, size_t count);
+
 /** Attribute report
  *
  * This API reports the attribute value.
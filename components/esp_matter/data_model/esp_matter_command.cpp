@@ -16,6 +16,7 @@
 #include <esp_matter.h>
 #include <esp_matter_command.h>
 #include <esp_matter_core.h>
+#include <esp_matter_data_model_priv.h>
 
 #include <app-common/zap-generated/callback.h>
 #include <app/InteractionModelEngine.h>
@@ -36,11 +37,20 @@ void dispatch_single_cluster_command(const ConcreteCommandPath &command_path, TL
     uint16_t endpoint_id = command_path.mEndpointId;
     uint32_t cluster_id = command_path.mClusterId;
     uint32_t command_id = command_path.mCommandId;
-    ESP_LOGI(TAG, "Received command 0x%08" PRIX32 " for endpoint 0x%04" PRIX16 "'s cluster 0x%08" PRIX32 "", command_id, endpoint_id, cluster_id);
+    // Logged at verbose level, this runs for every invoke
+    ESP_LOGV(TAG, "Received command 0x%08" PRIX32 " for endpoint 0x%04" PRIX16 "'s cluster 0x%08" PRIX32 "", command_id, endpoint_id, cluster_id);
 
     cluster_t *cluster = cluster::get(endpoint_id, cluster_id);
     VerifyOrReturn(cluster);
-    command_t *command = get(cluster, command_id, COMMAND_FLAG_ACCEPTED);
+    // Binary search in the sorted accepted commands of the cluster
+    dispatch_single_cluster_command(get(cluster, command_id, COMMAND_FLAG_ACCEPTED), command_path, tlv_data,
+                                    opaque_ptr);
+}
+
+void dispatch_single_cluster_command(command_t *command, const ConcreteCommandPath &command_path, TLVReader &tlv_data,
+                                     void *opaque_ptr)
+{
+    uint32_t command_id = command_path.mCommandId;
     VerifyOrReturn(command, ESP_LOGE(TAG, "Command 0x%08" PRIX32 " not found", command_id));
     esp_err_t err = ESP_OK;
     TLVReader tlv_reader;
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <esp_check.h>
@@ -19,18 +20,28 @@
 #include <esp_log.h>
 #include <esp_matter.h>
 #include <esp_matter_attribute_utils.h>
+#include <esp_matter_attribute_handle.h>
 #include <esp_matter_core.h>
 #include <esp_matter_data_model.h>
 #include <esp_matter_data_model_priv.h>
 #include <esp_matter_data_model_provider.h>
+#include <esp_matter_endpoint_table.h>
 #include <esp_matter_attr_data_buffer.h>
 #include <esp_matter_mem.h>
+#include <esp_matter_metadata_cache.h>
 #include <esp_matter_nvs.h>
+#include <esp_matter_nvs_stats.h>
+#include <esp_matter_path_index.h>
+#include <esp_matter_report_policy.h>
+#include <esp_matter_sealed_model.h>
+#include <esp_matter_typed_bounds.h>
+#include <esp_matter_write_behind.h>
 #include <esp_random.h>
 #include <nvs_flash.h>
 #include <singly_linked_list.h>
 
 #include <access/SubjectDescriptor.h>
+#include <app/AttributeAccessInterfaceRegistry.h>
 #include <app/clusters/identify-server/identify-server.h>
 #include <app/data-model-provider/MetadataTypes.h>
 #include <app/data-model-provider/Provider.h>
@@ -60,6 +71,7 @@ namespace esp_matter {
 
 struct _attribute_base_t {
     uint16_t flags; // This struct is for attributes managed internally.
+    uint16_t cluster_slot; // Slot of the parent cluster, it fits in the padding after flags.
     esp_matter_val_type_t attribute_val_type;
     uint32_t attribute_id;
     struct _attribute_base_t *next;
@@ -67,8 +79,10 @@ struct _attribute_base_t {
 
 struct _attribute_t : public _attribute_base_t {
     esp_matter_val_t attribute_val;
-    esp_matter_attr_bounds_t *bounds;
+    const attribute::bounds_header_t *bounds;
     uint16_t endpoint_id;
+    bool bounds_allocated; // Set if the bounds belong to this attribute, the shared bounds are not freed with it
+    bool has_report_policy; // Set if the attribute has a reporting policy, the updates of the others skip its lookup
     uint32_t cluster_id;
     attribute::callback_t override_callback;
 };
@@ -81,6 +95,13 @@ typedef struct _command {
     struct _command *next;
 } _command_t;
 
+/* Commands of a cluster sorted by id, followed by the accepted_count accepted commands and then the generated_count
+   generated commands. A command with both flags is in both ranges. */
+typedef struct command_table {
+    size_t accepted_count; /* size_t keeps the command pointers after the header aligned */
+    size_t generated_count;
+} command_table_t;
+
 typedef struct _event {
     uint32_t event_id;
     struct _event *next;
@@ -89,6 +110,7 @@ typedef struct _event {
 typedef struct _cluster {
     uint32_t cluster_id;
     uint16_t endpoint_id;
+    uint16_t slot;
     uint8_t flags;
     const cluster::function_generic_t *functions;
     cluster::plugin_server_init_callback_t plugin_server_init_callback;
@@ -98,9 +120,12 @@ typedef struct _cluster {
     cluster::initialization_callback_t init_callback;
     cluster::shutdown_callback_t shutdown_callback;
     chip::DataVersion data_version;
+    struct _cluster *template_cluster; /* If set, the command_list and event_list are shared with this cluster of an
+                                          endpoint template. They are copied before being changed. */
     _attribute_base_t *attribute_list; /* If attribute is managed internally, the actual pointer type is
                                      _internal_attribute_t. When operating attribute_list, do check the flags first! */
     _command_t *command_list;
+    command_table_t *command_table; /* Built on the first lookup, NULL when the command_list is shared */
     _event_t *event_list;
     struct _cluster *next;
 } _cluster_t;
@@ -122,13 +147,28 @@ typedef struct _endpoint {
     EndpointCompositionPattern composition_pattern;
     uint8_t semantic_tag_count;
     chip::app::DataModel::Provider::SemanticTag semantic_tags[ESP_MATTER_MAX_SEMANTIC_TAG_COUNT];
+    uint16_t server_cluster_count;
+    uint16_t client_cluster_count;
     _cluster_t *cluster_list;
     struct _endpoint *next;
 } _endpoint_t;
 
+typedef struct cluster_endpoint_count {
+    uint32_t cluster_id;
+    uint16_t server_count;
+    uint16_t client_count;
+} cluster_endpoint_count_t;
+
 typedef struct _node {
     _endpoint_t *endpoint_list;
     uint16_t min_unused_endpoint_id;
+    uint16_t endpoint_count;
+    /* Number of enabled endpoints which have each cluster, sorted by cluster id */
+    cluster_endpoint_count_t *cluster_counts;
+    uint16_t cluster_count_size;
+    uint16_t cluster_count_capacity;
+    /* Set if cluster_counts could not grow, the counts are then computed by walking the lists */
+    bool cluster_counts_incomplete;
 } _node_t;
 
 namespace {
@@ -151,10 +191,208 @@ const uint32_t k_max_tlv_size_to_write_attribute_value = 512;
 
 } // namespace
 
+namespace cluster {
+
+// The clusters are numbered with a slot in this table, so that an attribute can refer to its parent cluster with
+// 16 bits and its path can be resolved without searching the node.
+static _cluster_t **cluster_slots = nullptr;
+static uint16_t cluster_slot_capacity = 0;
+// All the slots below this one are in use
+static uint16_t cluster_slot_free_hint = 0;
+static constexpr uint16_t k_invalid_cluster_slot = UINT16_MAX;
+
+static uint16_t alloc_slot(_cluster_t *cluster)
+{
+    uint16_t slot = cluster_slot_free_hint;
+    while (slot < cluster_slot_capacity && cluster_slots[slot]) {
+        slot++;
+    }
+    if (slot == cluster_slot_capacity) {
+        VerifyOrReturnValue(cluster_slot_capacity < k_invalid_cluster_slot, k_invalid_cluster_slot,
+                            ESP_LOGE(TAG, "No more cluster slots"));
+        uint32_t new_capacity = cluster_slot_capacity ? cluster_slot_capacity * 2 : 32;
+        new_capacity = std::min<uint32_t>(new_capacity, k_invalid_cluster_slot);
+        _cluster_t **new_slots =
+            (_cluster_t **)esp_matter_mem_realloc(cluster_slots, new_capacity * sizeof(_cluster_t *));
+        VerifyOrReturnValue(new_slots, k_invalid_cluster_slot, ESP_LOGE(TAG, "Couldn't grow the cluster slots"));
+        memset(&new_slots[cluster_slot_capacity], 0, (new_capacity - cluster_slot_capacity) * sizeof(_cluster_t *));
+        cluster_slots = new_slots;
+        cluster_slot_capacity = new_capacity;
+    }
+    cluster_slots[slot] = cluster;
+    cluster_slot_free_hint = slot + 1;
+    return slot;
+}
+
+static void free_slot(uint16_t slot)
+{
+    VerifyOrReturn(slot < cluster_slot_capacity);
+    cluster_slots[slot] = nullptr;
+    cluster_slot_free_hint = std::min(cluster_slot_free_hint, slot);
+}
+
+static _cluster_t *get_by_slot(uint16_t slot)
+{
+    VerifyOrReturnValue(slot < cluster_slot_capacity, nullptr);
+    return cluster_slots[slot];
+}
+
+static void reset_slots()
+{
+    esp_matter_mem_free(cluster_slots);
+    cluster_slots = nullptr;
+    cluster_slot_capacity = 0;
+    cluster_slot_free_hint = 0;
+}
+
+template <typename T>
+static void free_copies(T *head)
+{
+    while (head) {
+        T *next = head->next;
+        esp_matter_mem_slab_free(head, sizeof(T));
+        head = next;
+    }
+}
+
+template <typename T>
+static esp_err_t copy_list(const T *head, T **copy)
+{
+    T **tail = copy;
+    *copy = nullptr;
+    for (; head; head = head->next) {
+        T *element = (T *)esp_matter_mem_slab_calloc(sizeof(T));
+        if (!element) {
+            free_copies(*copy);
+            *copy = nullptr;
+            return ESP_ERR_NO_MEM;
+        }
+        *element = *head;
+        element->next = nullptr;
+        *tail = element;
+        tail = &element->next;
+    }
+    return ESP_OK;
+}
+
+// Index the commands and events of a cluster whose lists were set as a whole
+static void index_metadata(_cluster_t *cluster)
+{
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        // Like command::create(), index the first command with a given id
+        _command_t *first = cluster->command_list;
+        while (first->command_id != command->command_id) {
+            first = first->next;
+        }
+        if (first == command) {
+            path_index::insert(path_index::ELEMENT_KIND_COMMAND, cluster->endpoint_id, cluster->cluster_id,
+                               command->command_id, command);
+        }
+    }
+    for (_event_t *event = cluster->event_list; event; event = event->next) {
+        path_index::insert(path_index::ELEMENT_KIND_EVENT, cluster->endpoint_id, cluster->cluster_id, event->event_id,
+                           event);
+    }
+}
+
+// Give the cluster its own copy of the commands and events which it shares with an endpoint template
+static esp_err_t unshare_metadata(_cluster_t *cluster)
+{
+    VerifyOrReturnValue(cluster->template_cluster, ESP_OK);
+    _command_t *commands = nullptr;
+    _event_t *events = nullptr;
+    VerifyOrReturnError(copy_list(cluster->command_list, &commands) == ESP_OK, ESP_ERR_NO_MEM,
+                        ESP_LOGE(TAG, "Couldn't copy the commands of the template"));
+    if (copy_list(cluster->event_list, &events) != ESP_OK) {
+        free_copies(commands);
+        ESP_LOGE(TAG, "Couldn't copy the events of the template");
+        return ESP_ERR_NO_MEM;
+    }
+    cluster->command_list = commands;
+    cluster->event_list = events;
+    cluster->template_cluster = nullptr;
+    index_metadata(cluster);
+    return ESP_OK;
+}
+
+} // namespace cluster
+
 namespace node {
 
 static _node_t *node = NULL;
 
+static cluster_endpoint_count_t *find_cluster_count(uint32_t cluster_id, bool insert)
+{
+    uint16_t low = 0, high = node->cluster_count_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (node->cluster_counts[mid].cluster_id < cluster_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < node->cluster_count_size && node->cluster_counts[low].cluster_id == cluster_id) {
+        return &node->cluster_counts[low];
+    }
+    VerifyOrReturnValue(insert, nullptr);
+
+    if (node->cluster_count_size == node->cluster_count_capacity) {
+        uint16_t capacity = node->cluster_count_capacity ? node->cluster_count_capacity * 2 : 16;
+        cluster_endpoint_count_t *counts = (cluster_endpoint_count_t *)esp_matter_mem_realloc(
+            node->cluster_counts, capacity * sizeof(cluster_endpoint_count_t));
+        if (!counts) {
+            ESP_LOGW(TAG, "Couldn't grow the cluster endpoint counts, they will be computed from the lists");
+            node->cluster_counts_incomplete = true;
+            return nullptr;
+        }
+        node->cluster_counts = counts;
+        node->cluster_count_capacity = capacity;
+    }
+    memmove(&node->cluster_counts[low + 1], &node->cluster_counts[low],
+            (node->cluster_count_size - low) * sizeof(cluster_endpoint_count_t));
+    node->cluster_counts[low] = {cluster_id, 0, 0};
+    node->cluster_count_size++;
+    return &node->cluster_counts[low];
+}
+
+static void count_cluster(uint32_t cluster_id, uint8_t flags, bool add)
+{
+    VerifyOrReturn(node && !node->cluster_counts_incomplete);
+    cluster_endpoint_count_t *count = find_cluster_count(cluster_id, add);
+    VerifyOrReturn(count);
+    if (flags & CLUSTER_FLAG_SERVER) {
+        add ? count->server_count++ : count->server_count--;
+    }
+    if (flags & CLUSTER_FLAG_CLIENT) {
+        add ? count->client_count++ : count->client_count--;
+    }
+}
+
+/* Add or remove the clusters of an endpoint which is enabled or disabled */
+static void count_endpoint_clusters(_endpoint_t *endpoint, bool add)
+{
+    // The endpoint templates are not part of the node
+    VerifyOrReturn(endpoint->endpoint_id != chip::kInvalidEndpointId);
+    for (_cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+        count_cluster(cluster->cluster_id, cluster->flags, add);
+    }
+}
+
+/* Add or remove the flags of a cluster which is created, extended or destroyed */
+static void count_endpoint_cluster(_endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags, bool add)
+{
+    if (flags & CLUSTER_FLAG_SERVER) {
+        add ? endpoint->server_cluster_count++ : endpoint->server_cluster_count--;
+    }
+    if (flags & CLUSTER_FLAG_CLIENT) {
+        add ? endpoint->client_cluster_count++ : endpoint->client_cluster_count--;
+    }
+    if (endpoint->enabled && endpoint->endpoint_id != chip::kInvalidEndpointId) {
+        count_cluster(cluster_id, flags, add);
+    }
+}
+
 // If Matter server or ESP-Matter data model is not enabled. we will never use minimum unused endpoint id.
 esp_err_t store_min_unused_endpoint_id()
 {
@@ -216,7 +454,11 @@ esp_err_t disable(endpoint_t *endpoint)
 {
     VerifyOrReturnError(endpoint, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Endpoint cannot be NULL"));
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    if (current_endpoint->enabled) {
+        node::count_endpoint_clusters(current_endpoint, false);
+    }
     current_endpoint->enabled = false;
+    endpoint_table::set_enabled(current_endpoint->endpoint_id, false);
     return ESP_OK;
 }
 
@@ -244,7 +486,11 @@ esp_err_t enable(endpoint_t *endpoint)
 {
     VerifyOrReturnError(endpoint, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Endpoint cannot be NULL"));
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    if (!current_endpoint->enabled) {
+        node::count_endpoint_clusters(current_endpoint, true);
+    }
     current_endpoint->enabled = true;
+    endpoint_table::set_enabled(current_endpoint->endpoint_id, true);
     init_identification(endpoint);
     return ESP_OK;
 }
@@ -306,185 +552,24 @@ static esp_err_t execute_callback(callback_type_t type, uint16_t endpoint_id, ui
     return ESP_OK;
 }
 
-/**
- * Check whether the attribute value is in the range of attribute bounds
- *
- * @param[in] val Attribute value.
- * @param[in] bounds Attribute bounds.
- *
- * @return 0 if val is in the range of attribute bounds.
- * @return 1 if val is more than bounds.max
- * @return -1 if val is less than bounds.min
- * @return -2 if val type is wrong
- */
-static int compare_attr_val_with_bounds(esp_matter_attr_val_t val, esp_matter_attr_bounds_t bounds)
-{
-    switch (val.type) {
-    case ESP_MATTER_VAL_TYPE_UINT8:
-    case ESP_MATTER_VAL_TYPE_ENUM8:
-    case ESP_MATTER_VAL_TYPE_BITMAP8:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8: {
-        using Traits = chip::app::NumericAttributeTraits<uint8_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.u8)) {
-            return 0;
-        }
-        if (val.val.u8 < bounds.min.val.u8) {
-            return -1;
-        } else if (val.val.u8 > bounds.max.val.u8) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_UINT16:
-    case ESP_MATTER_VAL_TYPE_ENUM16:
-    case ESP_MATTER_VAL_TYPE_BITMAP16:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16: {
-        using Traits = chip::app::NumericAttributeTraits<uint16_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.u16)) {
-            return 0;
-        }
-        if (val.val.u16 < bounds.min.val.u16) {
-            return -1;
-        } else if (val.val.u16 > bounds.max.val.u16) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_UINT32:
-    case ESP_MATTER_VAL_TYPE_BITMAP32:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32: {
-        using Traits = chip::app::NumericAttributeTraits<uint32_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.u32)) {
-            return 0;
-        }
-        if (val.val.u32 < bounds.min.val.u32) {
-            return -1;
-        } else if (val.val.u32 > bounds.max.val.u32) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_UINT64:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64: {
-        using Traits = chip::app::NumericAttributeTraits<uint64_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.u64)) {
-            return 0;
-        }
-        if (val.val.u64 < bounds.min.val.u64) {
-            return -1;
-        } else if (val.val.u64 > bounds.max.val.u64) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_INT8:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8: {
-        using Traits = chip::app::NumericAttributeTraits<int8_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.i8)) {
-            return 0;
-        }
-        if (val.val.i8 < bounds.min.val.i8) {
-            return -1;
-        } else if (val.val.i8 > bounds.max.val.i8) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_INT16:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16: {
-        using Traits = chip::app::NumericAttributeTraits<int16_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.i16)) {
-            return 0;
-        }
-        if (val.val.i16 < bounds.min.val.i16) {
-            return -1;
-        } else if (val.val.i16 > bounds.max.val.i16) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_INT32:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32: {
-        using Traits = chip::app::NumericAttributeTraits<int32_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.i32)) {
-            return 0;
-        }
-        if (val.val.i32 < bounds.min.val.i32) {
-            return -1;
-        } else if (val.val.i32 > bounds.max.val.i32) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_INT64:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64: {
-        using Traits = chip::app::NumericAttributeTraits<int64_t>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.i64)) {
-            return 0;
-        }
-        if (val.val.i64 < bounds.min.val.i64) {
-            return -1;
-        } else if (val.val.i64 > bounds.max.val.i64) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    case ESP_MATTER_VAL_TYPE_FLOAT:
-    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT: {
-        using Traits = chip::app::NumericAttributeTraits<float>;
-        if ((val.type & ESP_MATTER_VAL_NULLABLE_BASE) && Traits::IsNullValue(val.val.f)) {
-            return 0;
-        }
-        if (val.val.f < bounds.min.val.f) {
-            return -1;
-        } else if (val.val.f > bounds.max.val.f) {
-            return 1;
-        } else {
-            return 0;
-        }
-        break;
-    }
-    default:
-        ESP_LOGE(TAG, "Failed to compare_attr_val_with_bounds as the attribute value type is wrong");
-        break;
+static void free_bounds(_attribute_t *attribute)
+{
+    if (attribute->bounds_allocated) {
+        esp_matter_mem_free(const_cast<bounds_header_t *>(attribute->bounds));
     }
-    return -2;
+    attribute->bounds = nullptr;
+    attribute->bounds_allocated = false;
 }
 
 static esp_err_t bound_attribute_val(attribute_t *attribute)
 {
     _attribute_t *current_attribute = (_attribute_t *)attribute;
-    esp_matter_attr_val_t temp_val;
-    temp_val.type = current_attribute->attribute_val_type;
-    temp_val.val = current_attribute->attribute_val;
-    int compare_result = compare_attr_val_with_bounds(temp_val, *current_attribute->bounds);
-    if (compare_result == 1) {
-        current_attribute->attribute_val = current_attribute->bounds->max.val;
-    } else if (compare_result == -1) {
-        current_attribute->attribute_val = current_attribute->bounds->min.val;
-    } else if (compare_result != 0) {
-        return ESP_ERR_INVALID_ARG;
+    const bounds_header_t *bounds = current_attribute->bounds;
+    int compare_result = bounds->ops->compare(bounds, current_attribute->attribute_val);
+    if (compare_result != 0) {
+        esp_matter_val_t min, max;
+        bounds->ops->get(bounds, &min, &max);
+        current_attribute->attribute_val = compare_result > 0 ? max : min;
     }
     return ESP_OK;
 }
@@ -505,23 +590,25 @@ attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, e
 
     if (flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
         /* Create */
-        attribute = (_attribute_t *)esp_matter_mem_calloc(1, sizeof(_attribute_base_t));
+        attribute = (_attribute_t *)esp_matter_mem_slab_calloc(sizeof(_attribute_base_t));
         if (!attribute) {
             return nullptr;
         }
 
         /* Set */
         attribute->flags = flags;
+        attribute->cluster_slot = current_cluster->slot;
         attribute->attribute_val_type = val.type;
         attribute->attribute_id = attribute_id;
     } else {
-        attribute = (_attribute_t *)esp_matter_mem_calloc(1, sizeof(_attribute_t));
+        attribute = (_attribute_t *)esp_matter_mem_slab_calloc(sizeof(_attribute_t));
         if (!attribute) {
             return nullptr;
         }
 
         /* Set */
         attribute->flags = flags;
+        attribute->cluster_slot = current_cluster->slot;
         attribute->attribute_id = attribute_id;
         attribute->override_callback = nullptr;
         attribute->cluster_id = current_cluster->cluster_id;
@@ -533,14 +620,18 @@ attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, e
             val.val.a.max = max_val_size;
         }
         bool attribute_updated = false;
-        if (flags & ATTRIBUTE_FLAG_NONVOLATILE) {
+        // The attributes of an endpoint template are never stored
+        if ((flags & ATTRIBUTE_FLAG_NONVOLATILE) && attribute->endpoint_id != chip::kInvalidEndpointId) {
             // read from the NVS and store in the attribute's storage
             esp_matter_attr_val_t temp_val;
             temp_val.type = attribute->attribute_val_type;
+            temp_val.val = attribute->attribute_val;
             esp_err_t err =
                 get_val_from_nvs(attribute->endpoint_id, attribute->cluster_id, attribute_id, temp_val);
             if (err == ESP_OK) {
                 attribute->attribute_val = temp_val.val;
+                // The buffer allocated for the stored string is reused by the following values which fit in it
+                attribute->attribute_val.a.cap = attribute->attribute_val.a.b ? attribute->attribute_val.a.s : 0;
                 attribute_updated = true;
             }
         }
@@ -551,6 +642,9 @@ attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, e
 
     /* Add */
     SinglyLinkedList<_attribute_base_t>::append(&current_cluster->attribute_list, attribute);
+    path_index::insert(path_index::ELEMENT_KIND_ATTRIBUTE, current_cluster->endpoint_id, current_cluster->cluster_id,
+                       attribute_id, attribute);
+    sealed_model::invalidate();
     return (attribute_t *)attribute;
 }
 
@@ -561,10 +655,14 @@ static esp_err_t destroy(attribute_t *attribute)
 
     if (current_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
         // For attribute managed internally, free as the _attribute_base_t pointer.
-        esp_matter_mem_free((_attribute_base_t *)attribute);
+        esp_matter_mem_slab_free((_attribute_base_t *)attribute, sizeof(_attribute_base_t));
         return ESP_OK;
     }
 
+    report_policy::remove(attribute);
+    write_behind::remove(attribute);
+    free_bounds(current_attribute);
+
     /* Delete val here, if required */
     if (current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
         current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
@@ -576,13 +674,14 @@ static esp_err_t destroy(attribute_t *attribute)
     }
 
     /* Erase the persistent data */
-    if (attribute::get_flags(attribute) & ATTRIBUTE_FLAG_NONVOLATILE) {
+    if ((attribute::get_flags(attribute) & ATTRIBUTE_FLAG_NONVOLATILE) &&
+        current_attribute->endpoint_id != chip::kInvalidEndpointId) {
         erase_val_in_nvs(current_attribute->endpoint_id, current_attribute->cluster_id,
                          current_attribute->attribute_id);
     }
 
     /* Free */
-    esp_matter_mem_free(current_attribute);
+    esp_matter_mem_slab_free(current_attribute, sizeof(_attribute_t));
     return ESP_OK;
 }
 
@@ -590,6 +689,11 @@ attribute_t *get(cluster_t *cluster, uint32_t attribute_id)
 {
     VerifyOrReturnValue(cluster, NULL, ESP_LOGE(TAG, "Cluster cannot be NULL."));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
+    void *indexed_attribute = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_ATTRIBUTE, current_cluster->endpoint_id, current_cluster->cluster_id,
+                         attribute_id, &indexed_attribute)) {
+        return (attribute_t *)indexed_attribute;
+    }
     _attribute_base_t *current_attribute = current_cluster->attribute_list;
     while (current_attribute) {
         if (current_attribute->attribute_id == attribute_id) {
@@ -603,6 +707,11 @@ attribute_t *get(cluster_t *cluster, uint32_t attribute_id)
 
 attribute_t *get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
 {
+    void *indexed_attribute = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_ATTRIBUTE, endpoint_id, cluster_id, attribute_id,
+                         &indexed_attribute)) {
+        return (attribute_t *)indexed_attribute;
+    }
     cluster_t *cluster = cluster::get(endpoint_id, cluster_id);
     return get(cluster, attribute_id);
 }
@@ -639,7 +748,7 @@ static void deferred_attribute_write(chip::System::Layer *layer, void *attribute
                      {current_attribute->attribute_val_type, current_attribute->attribute_val});
 }
 
-esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_callbacks)
+esp_err_t check_val_internal(attribute_t *attribute, const esp_matter_attr_val_t *val)
 {
     VerifyOrReturnError(attribute && val, ESP_ERR_INVALID_ARG);
     _attribute_t *current_attribute = (_attribute_t *)attribute;
@@ -647,19 +756,44 @@ esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, b
     ESP_RETURN_ON_FALSE(!(current_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), ESP_ERR_NOT_SUPPORTED, TAG,
                         "Attribute is not managed by esp matter data model");
 
-    // As we know that this is esp-matter managed attribute, we can safely log the path
-    ESP_LOGD(TAG, "setting attribute value for: 0x%x:0x%" PRIx32 ":0x%" PRIx32, current_attribute->endpoint_id,
-             current_attribute->cluster_id, current_attribute->attribute_id);
-
     VerifyOrReturnError(current_attribute->attribute_val_type == val->type, ESP_ERR_INVALID_ARG,
                         ESP_LOGE(TAG, "Different value type : Expected Type : %u Attempted Type: %u",
                             current_attribute->attribute_val_type, val->type));
 
     if ((current_attribute->flags & ATTRIBUTE_FLAG_MIN_MAX) && current_attribute->bounds) {
-        if (compare_attr_val_with_bounds(*val, *current_attribute->bounds) != 0) {
+        const bounds_header_t *bounds = current_attribute->bounds;
+        if (bounds->ops->compare(bounds, val->val) != 0) {
             return ESP_ERR_INVALID_ARG;
         }
     }
+    if (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING) {
+        uint16_t null_len =
+            (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING)
+            ? UINT8_MAX
+            : UINT16_MAX;
+        if (val->val.a.s != null_len && val->val.a.s > current_attribute->attribute_val.a.max) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t prepare_val(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_callbacks)
+{
+    VerifyOrReturnError(attribute && val, ESP_ERR_INVALID_ARG);
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+
+    ESP_RETURN_ON_FALSE(!(current_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Attribute is not managed by esp matter data model");
+
+    // As we know that this is esp-matter managed attribute, we can safely log the path
+    ESP_LOGD(TAG, "setting attribute value for: 0x%x:0x%" PRIx32 ":0x%" PRIx32, current_attribute->endpoint_id,
+             current_attribute->cluster_id, current_attribute->attribute_id);
+
+    esp_err_t err = check_val_internal(attribute, val);
+    VerifyOrReturnError(err == ESP_OK, err);
+
     esp_matter_attr_val_t temp_val;
     temp_val.type = current_attribute->attribute_val_type;
     temp_val.val = current_attribute->attribute_val;
@@ -673,6 +807,24 @@ esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, b
                                          current_attribute->cluster_id, current_attribute->attribute_id, val),
                             TAG, "Failed to execute pre update callback");
     }
+    return ESP_OK;
+}
+
+esp_err_t pre_update_internal(attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    return prepare_val(attribute, val, true);
+}
+
+esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_callbacks)
+{
+    esp_err_t err = prepare_val(attribute, val, call_callbacks);
+    VerifyOrReturnError(err == ESP_OK, err);
+    return set_prepared_val_internal(attribute, val, call_callbacks);
+}
+
+esp_err_t set_prepared_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_callbacks)
+{
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
     // TODO: call pre attribute change function is the cluster has the flag
     if (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
         val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING) {
@@ -683,20 +835,31 @@ esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, b
         if (val->val.a.s > 0) {
             uint8_t *new_buf = nullptr;
             if (val->val.a.s != null_len) {
-                if (val->val.a.s > current_attribute->attribute_val.a.max) {
-                    return ESP_ERR_NO_MEM;
-                }
-                /* Free old buf */
-                esp_matter_mem_free(current_attribute->attribute_val.a.b);
-                current_attribute->attribute_val.a.b = nullptr;
-
                 bool null_reserve =
                     val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING;
-                /* Alloc new buf */
-                new_buf = (uint8_t *)esp_matter_mem_calloc(1, val->val.a.s + (null_reserve ? 1 : 0));
-                VerifyOrReturnError(new_buf, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Could not allocate new buffer"));
-                /* Copy to new buf and assign */
-                memcpy(new_buf, val->val.a.b, val->val.a.s);
+                uint8_t *old_buf = current_attribute->attribute_val.a.b;
+                new_buf = old_buf;
+                if (!new_buf || val->val.a.s > current_attribute->attribute_val.a.cap) {
+                    /* Alloc new buf, rounded up so that slightly longer values still fit in it */
+                    uint16_t capacity = (uint16_t)std::min<uint32_t>((val->val.a.s + 7u) & ~7u,
+                                                                     current_attribute->attribute_val.a.max);
+                    new_buf = (uint8_t *)esp_matter_mem_calloc(1, capacity + (null_reserve ? 1 : 0));
+                    VerifyOrReturnError(new_buf, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Could not allocate new buffer"));
+                    current_attribute->attribute_val.a.cap = capacity;
+                }
+                /* Copy to the buf, the new value might come from the old buf */
+                memmove(new_buf, val->val.a.b, val->val.a.s);
+                if (null_reserve) {
+                    new_buf[val->val.a.s] = '\0';
+                }
+                if (new_buf != old_buf) {
+                    /* Free old buf */
+                    esp_matter_mem_free(old_buf);
+                }
+            } else {
+                /* Free old buf, a null string has no buffer */
+                esp_matter_mem_free(current_attribute->attribute_val.a.b);
+                current_attribute->attribute_val.a.cap = 0;
             }
             current_attribute->attribute_val.a.b = new_buf;
             current_attribute->attribute_val.a.s = val->val.a.s;
@@ -722,6 +885,13 @@ esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, b
         }
     }
     if (current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BEHIND
+        if (write_behind::mark_dirty(attribute, current_attribute->endpoint_id, current_attribute->cluster_id,
+                                     current_attribute->attribute_id,
+                                     current_attribute->flags & ATTRIBUTE_FLAG_DEFERRED) == ESP_OK) {
+            return ESP_OK;
+        }
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BEHIND
         if (current_attribute->flags & ATTRIBUTE_FLAG_DEFERRED) {
             if (!chip::DeviceLayer::SystemLayer().IsTimerActive(deferred_attribute_write, current_attribute)) {
                 auto &system_layer = chip::DeviceLayer::SystemLayer();
@@ -798,8 +968,8 @@ static esp_err_t get_val_from_tlv_data(const uint8_t *tlv_data, uint32_t tlv_len
 
     *val = data_buffer.get_attr_val();
 
-    // attribute_data_decode_buffer's destructor frees the buffer so we need to copy the buffer to a new buffer
-    // and pass on to the user. This is only required for string and octet string types
+    // The decoded string lives in the TLV data or in a buffer released by attribute_data_decode_buffer's destructor,
+    // so we need to copy the buffer to a new buffer and pass on to the user. This is only required for string and octet string types
 
     bool is_type_string = (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING
                             || val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING);
@@ -822,37 +992,52 @@ static esp_err_t get_val_from_tlv_data(const uint8_t *tlv_data, uint32_t tlv_len
     return ESP_OK;
 }
 
-// Helper function to find the cluster_id and attribute_id for internally managed attributes
-static esp_err_t find_cluster_and_endpoint_id_for_internally_managed_attribute(const _attribute_base_t *attribute_base,
-                                                                                uint16_t &out_endpoint_id,
-                                                                                uint32_t &out_cluster_id)
+// The cluster has an AttributeAccessInterface or a ServerClusterInterface which may serve the attribute read
+// instead of the esp-matter storage.
+static bool has_read_override(uint16_t endpoint_id, uint32_t cluster_id)
 {
-    VerifyOrReturnError(attribute_base, ESP_ERR_INVALID_ARG);
-    _node_t *node = (_node_t *)node::get();
-    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE);
+    if (data_model::provider::get_instance().registry().Get(chip::app::ConcreteClusterPath(endpoint_id, cluster_id))) {
+        return true;
+    }
+    return chip::app::AttributeAccessInterfaceRegistry::Instance().Get(endpoint_id, cluster_id) != nullptr;
+}
 
-    // This is a linear search and it's not efficient, but we don't have a better way to do it right now.
-    for (_endpoint_t *endpoint = node->endpoint_list; endpoint != nullptr; endpoint = endpoint->next) {
-        for (_cluster_t *cluster = endpoint->cluster_list; cluster != nullptr; cluster = cluster->next) {
-            for (_attribute_base_t *attr = cluster->attribute_list; attr != nullptr; attr = attr->next) {
-                if (attr == attribute_base) {
-                    out_endpoint_id = endpoint->endpoint_id;
-                    out_cluster_id = cluster::get_id((cluster_t *)cluster);
-                    return ESP_OK;
-                }
-            }
-        }
+// Copy the value out of the esp-matter storage. Like the values decoded from the TLV report, the string buffers
+// are duplicated and the new buffer is owned by the caller.
+static esp_err_t copy_val_from_storage(const _attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    val->type = attribute->attribute_val_type;
+    val->val = attribute->attribute_val;
+
+    bool is_type_string = (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING
+                            || val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING);
+    bool is_type_octet_string = (val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING
+                                    || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING);
+
+    if ((is_type_string || is_type_octet_string) && attribute->attribute_val.a.b) {
+        // the null terminator is reserved for char strings
+        uint8_t *new_buf = (uint8_t *)esp_matter_mem_calloc(sizeof(uint8_t), val->val.a.s + (is_type_string ? 1 : 0));
+        VerifyOrReturnError(new_buf != nullptr, ESP_ERR_NO_MEM);
+        memcpy(new_buf, attribute->attribute_val.a.b, val->val.a.s);
+        val->val.a.b = new_buf;
     }
-    return ESP_ERR_NOT_FOUND;
+    return ESP_OK;
 }
 
 esp_err_t get_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
 {
     VerifyOrReturnError(val, ESP_ERR_INVALID_ARG);
-    esp_matter_val_type_t val_type = get_val_type(endpoint_id, cluster_id, attribute_id);
+    attribute_t *attribute = get(endpoint_id, cluster_id, attribute_id);
+    esp_matter_val_type_t val_type = get_val_type(attribute);
     VerifyOrReturnError(val_type != ESP_MATTER_VAL_TYPE_INVALID, ESP_ERR_INVALID_ARG);
     VerifyOrReturnError(val_type != ESP_MATTER_VAL_TYPE_ARRAY, ESP_ERR_NOT_SUPPORTED);
 
+    // The value of the attribute managed by esp-matter can be copied directly, only the values owned by the
+    // connectedhomeip clusters need the round trip through the TLV report.
+    if (!(get_flags(attribute) & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) && !has_read_override(endpoint_id, cluster_id)) {
+        return copy_val_from_storage((_attribute_t *)attribute, val);
+    }
+
     chip::Platform::ScopedMemoryBuffer<uint8_t> scoped_buf;
     scoped_buf.Calloc(k_max_tlv_size_to_read_attribute_value);
     if (scoped_buf.IsNull()) {
@@ -894,8 +1079,12 @@ static esp_err_t get_path_from_attribute_handle(const _attribute_t *attribute, u
 {
     attribute_id = attribute->attribute_id;
     if (attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
-        // for connectedhomeip managed attributes, we need to find the cluster and endpoint id
-        return find_cluster_and_endpoint_id_for_internally_managed_attribute(attribute, endpoint_id, cluster_id);
+        // for connectedhomeip managed attributes, the path comes from the parent cluster
+        const _cluster_t *cluster = cluster::get_by_slot(attribute->cluster_slot);
+        VerifyOrReturnError(cluster, ESP_ERR_NOT_FOUND);
+        endpoint_id = cluster->endpoint_id;
+        cluster_id = cluster->cluster_id;
+        return ESP_OK;
     }
 
     // in case of esp-matter managed attributes, we can directly use the endpoint and cluster id
@@ -1047,12 +1236,8 @@ esp_err_t add_bounds(attribute_t *attribute, esp_matter_attr_val_t min, esp_matt
                         "Attribute is not managed by esp matter data model");
 
     /* Check if bounds can be set */
-    if (current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-        current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
-        current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-        current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
-        current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_ARRAY ||
-        current_attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_BOOLEAN) {
+    const bounds_ops_t *ops = get_bounds_ops(current_attribute->attribute_val_type);
+    if (!ops) {
         ESP_LOGE(TAG, "Bounds cannot be set for string/array/boolean type attributes");
         return ESP_ERR_INVALID_ARG;
     }
@@ -1060,14 +1245,35 @@ esp_err_t add_bounds(attribute_t *attribute, esp_matter_attr_val_t min, esp_matt
                         ESP_ERR_INVALID_ARG,
                         ESP_LOGE(TAG, "Cannot set bounds because of val type mismatch: expected: %d, min: %d, max: %d",
                                  current_attribute->attribute_val_type, min.type, max.type));
-    current_attribute->bounds = (esp_matter_attr_bounds_t *)esp_matter_mem_calloc(1, sizeof(esp_matter_attr_bounds_t));
-    if (!current_attribute->bounds) {
+    bounds_header_t *bounds = (bounds_header_t *)esp_matter_mem_calloc(1, ops->size);
+    if (!bounds) {
         ESP_LOGE(TAG, "Failed to allocate bounds for attribute");
         return ESP_ERR_NO_MEM;
     }
+    bounds->ops = ops;
+    ops->set(bounds, min.val, max.val);
+    free_bounds(current_attribute);
+    current_attribute->bounds = bounds;
+    current_attribute->bounds_allocated = true;
+    current_attribute->flags |= ATTRIBUTE_FLAG_MIN_MAX;
+    return bound_attribute_val(attribute);
+}
+
+esp_err_t set_shared_bounds(attribute_t *attribute, const bounds_header_t *bounds)
+{
+    VerifyOrReturnError(attribute && bounds, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Attribute or bounds cannot be NULL"));
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+
+    ESP_RETURN_ON_FALSE(!(current_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Attribute is not managed by esp matter data model");
+    VerifyOrReturnError(bounds->ops == get_bounds_ops(current_attribute->attribute_val_type), ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Cannot set bounds because of val type mismatch: expected: %d",
+                                 current_attribute->attribute_val_type));
+    if (current_attribute->bounds != bounds) {
+        free_bounds(current_attribute);
+        current_attribute->bounds = bounds;
+    }
     current_attribute->flags |= ATTRIBUTE_FLAG_MIN_MAX;
-    current_attribute->bounds->min = min;
-    current_attribute->bounds->max = max;
     return bound_attribute_val(attribute);
 }
 
@@ -1083,13 +1289,15 @@ esp_err_t get_bounds(attribute_t *attribute, esp_matter_attr_bounds_t *bounds)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!(current_attribute->flags & ATTRIBUTE_FLAG_MIN_MAX)) {
+    if (!(current_attribute->flags & ATTRIBUTE_FLAG_MIN_MAX) || !current_attribute->bounds) {
         ESP_LOGW(TAG,
                  "Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32 " has not set bounds",
                  current_attribute->endpoint_id, current_attribute->cluster_id, current_attribute->attribute_id);
         return ESP_ERR_INVALID_ARG;
     }
-    *bounds = *current_attribute->bounds;
+    bounds->min.type = current_attribute->attribute_val_type;
+    bounds->max.type = current_attribute->attribute_val_type;
+    current_attribute->bounds->ops->get(current_attribute->bounds, &bounds->min.val, &bounds->max.val);
     return ESP_OK;
 }
 
@@ -1150,9 +1358,228 @@ esp_err_t set_deferred_persistence(attribute_t *attribute)
     return ESP_OK;
 }
 
+esp_err_t set_report_policy(attribute_t *attribute, const report_policy_t *policy)
+{
+    VerifyOrReturnError(attribute, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Attribute cannot be NULL"));
+    _attribute_base_t *attribute_base = (_attribute_base_t *)attribute;
+    ESP_RETURN_ON_FALSE(!(attribute_base->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Attribute is not managed by esp matter data model");
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    switch (current_attribute->attribute_val_type) {
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        ESP_LOGE(TAG, "Reporting policy can only be set for the numeric attributes");
+        return ESP_ERR_NOT_SUPPORTED;
+    default:
+        break;
+    }
+    esp_err_t err = report_policy::set(attribute, current_attribute->endpoint_id, current_attribute->cluster_id,
+                                       current_attribute->attribute_id, policy);
+    if (err == ESP_OK) {
+        current_attribute->has_report_policy = policy != NULL;
+    }
+    return err;
+}
+
+bool has_report_policy(attribute_t *attribute)
+{
+    const _attribute_base_t *attribute_base = (const _attribute_base_t *)attribute;
+    VerifyOrReturnValue(attribute_base && !(attribute_base->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), false);
+    return ((const _attribute_t *)attribute)->has_report_policy;
+}
+
+esp_err_t flush_persistence()
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
+    esp_err_t err = write_behind::flush();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t get_persistence_stats(persistence_stats_t *stats)
+{
+    VerifyOrReturnError(stats, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Stats cannot be NULL"));
+    write_behind::get_stats(stats);
+    return ESP_OK;
+}
+
+esp_err_t get_nvs_partition_stats(nvs_partition_stats_t *stats)
+{
+    VerifyOrReturnError(stats, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Stats cannot be NULL"));
+    nvs_stats_t nvs_stats;
+    esp_err_t err = nvs_get_stats(ESP_MATTER_NVS_PART_NAME, &nvs_stats);
+    VerifyOrReturnError(err == ESP_OK, err, ESP_LOGE(TAG, "Failed to get the NVS statistics"));
+    stats->used_entries = nvs_stats.used_entries;
+    stats->free_entries = nvs_stats.free_entries;
+    stats->total_entries = nvs_stats.total_entries;
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
+    nvs_stats::get_stats(stats);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t for_each_nvs_path_stats(nvs_path_stats_callback_t callback, void *priv_data)
+{
+    VerifyOrReturnError(callback, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Callback cannot be NULL"));
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
+    esp_err_t err = nvs_stats::for_each_path(callback, priv_data);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t reset_nvs_stats()
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
+    nvs_stats::reset();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t set_nvs_write_rate_callback(nvs_write_rate_callback_t callback)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    VerifyOrReturnError(lock_status != lock::FAILED, ESP_FAIL, ESP_LOGE(TAG, "Could not get task context"));
+    nvs_stats::set_write_rate_callback(callback);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+namespace detail {
+
+esp_err_t resolve_handle(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                         bool (*matches)(esp_matter_val_type_t type), handle_base_t *base)
+{
+    VerifyOrReturnError(matches && base, ESP_ERR_INVALID_ARG);
+    *base = {};
+    attribute_t *attribute = get(endpoint_id, cluster_id, attribute_id);
+    VerifyOrReturnError(attribute, ESP_ERR_NOT_FOUND,
+                        ESP_LOGE(TAG, "Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32
+                                 " not found", endpoint_id, cluster_id, attribute_id));
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    ESP_RETURN_ON_FALSE(!(current_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Attribute is not managed by esp matter data model");
+    VerifyOrReturnError(matches(current_attribute->attribute_val_type), ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "The handle type does not match the attribute val type: %d",
+                                 current_attribute->attribute_val_type));
+    base->attribute = attribute;
+    base->val = &current_attribute->attribute_val;
+    base->type = current_attribute->attribute_val_type;
+    base->endpoint_id = endpoint_id;
+    base->cluster_id = cluster_id;
+    base->attribute_id = attribute_id;
+    return ESP_OK;
+}
+
+esp_err_t set_handle_val(const handle_base_t &base, const esp_matter_val_t &val, bool call_callbacks)
+{
+    esp_matter_attr_val_t attr_val = {base.type, val};
+    return set_val_internal(base.attribute, &attr_val, call_callbacks);
+}
+
+} // namespace detail
+
 } // namespace attribute
 
 namespace command {
+
+static _command_t **get_table_commands(command_table_t *table)
+{
+    return (_command_t **)(table + 1);
+}
+
+static size_t get_table_size(const command_table_t *table)
+{
+    return sizeof(command_table_t) + (table->accepted_count + table->generated_count) * sizeof(_command_t *);
+}
+
+static void sort_commands(_command_t **commands, size_t count)
+{
+    // The lists are short and mostly created in id order, insertion sort is the cheapest here
+    for (size_t i = 1; i < count; ++i) {
+        _command_t *command = commands[i];
+        size_t j = i;
+        for (; j > 0 && commands[j - 1]->command_id > command->command_id; --j) {
+            commands[j] = commands[j - 1];
+        }
+        commands[j] = command;
+    }
+}
+
+static command_table_t *build_table(_cluster_t *cluster)
+{
+    size_t accepted_count = 0, generated_count = 0;
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        accepted_count += (command->flags & COMMAND_FLAG_ACCEPTED) ? 1 : 0;
+        generated_count += (command->flags & COMMAND_FLAG_GENERATED) ? 1 : 0;
+    }
+    command_table_t *table = (command_table_t *)esp_matter_mem_calloc(
+        1, sizeof(command_table_t) + (accepted_count + generated_count) * sizeof(_command_t *));
+    VerifyOrReturnValue(table, nullptr, ESP_LOGE(TAG, "Couldn't allocate the command table"));
+    table->accepted_count = accepted_count;
+    table->generated_count = generated_count;
+    _command_t **accepted = get_table_commands(table);
+    _command_t **generated = accepted + accepted_count;
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        if (command->flags & COMMAND_FLAG_ACCEPTED) {
+            *accepted++ = command;
+        }
+        if (command->flags & COMMAND_FLAG_GENERATED) {
+            *generated++ = command;
+        }
+    }
+    sort_commands(get_table_commands(table), accepted_count);
+    sort_commands(get_table_commands(table) + accepted_count, generated_count);
+    return table;
+}
+
+// The clusters which share the commands of a template use the table of the template
+static command_table_t *get_table(_cluster_t *cluster)
+{
+    _cluster_t *owner = cluster->template_cluster ? cluster->template_cluster : cluster;
+    if (!owner->command_table) {
+        owner->command_table = build_table(owner);
+    }
+    return owner->command_table;
+}
+
+static void free_table(_cluster_t *cluster)
+{
+    esp_matter_mem_free(cluster->command_table);
+    cluster->command_table = nullptr;
+}
+
+static _command_t *find_in_table(_command_t *const *commands, size_t count, uint32_t command_id)
+{
+    size_t low = 0, high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (commands[mid]->command_id < command_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    VerifyOrReturnValue(low < count && commands[low]->command_id == command_id, nullptr);
+    return commands[low];
+}
+
 command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback)
 {
     /* Find */
@@ -1164,9 +1591,10 @@ command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callba
                  command_id, cluster::get_id(cluster));
         return existing_command;
     }
+    VerifyOrReturnValue(cluster::unshare_metadata(current_cluster) == ESP_OK, NULL);
 
     /* Allocate */
-    _command_t *command = (_command_t *)esp_matter_mem_calloc(1, sizeof(_command_t));
+    _command_t *command = (_command_t *)esp_matter_mem_slab_calloc(sizeof(_command_t));
     VerifyOrReturnValue(command, NULL, ESP_LOGE(TAG, "Couldn't allocate _command_t"));
 
     /* Set */
@@ -1176,12 +1604,25 @@ command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callba
     command->user_callback = NULL;
 
     /* Add */
+    // A command id can be in the list twice, one accepted and one generated. The index keeps the first one, which
+    // is what a lookup without flags returns.
+    bool first_with_id = !get(current_cluster->endpoint_id, current_cluster->cluster_id, command_id);
     SinglyLinkedList<_command_t>::append(&current_cluster->command_list, command);
+    if (first_with_id) {
+        path_index::insert(path_index::ELEMENT_KIND_COMMAND, current_cluster->endpoint_id, current_cluster->cluster_id,
+                           command_id, command);
+    }
+    free_table(current_cluster);
+    sealed_model::invalidate();
     return (command_t *)command;
 }
 
 command_t *get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id)
 {
+    void *indexed_command = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_COMMAND, endpoint_id, cluster_id, command_id, &indexed_command)) {
+        return (command_t *)indexed_command;
+    }
     _cluster_t *current_cluster = (_cluster_t *)cluster::get(endpoint_id, cluster_id);
     VerifyOrReturnValue(current_cluster, NULL);
     _command_t *command = (_command_t *)current_cluster->command_list;
@@ -1199,7 +1640,27 @@ command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags)
 {
     VerifyOrReturnValue(cluster, NULL, ESP_LOGE(TAG, "Cluster cannot be NULL."));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
+    command_table_t *table = (flags & ~(COMMAND_FLAG_ACCEPTED | COMMAND_FLAG_GENERATED)) ? nullptr :
+                                                                                           get_table(current_cluster);
+    if (table) {
+        _command_t **commands = get_table_commands(table);
+        _command_t *command = nullptr;
+        if (flags & COMMAND_FLAG_ACCEPTED) {
+            command = find_in_table(commands, table->accepted_count, command_id);
+        }
+        if (!command && (flags & COMMAND_FLAG_GENERATED)) {
+            command = find_in_table(commands + table->accepted_count, table->generated_count, command_id);
+        }
+        return (command_t *)command;
+    }
+    // Look up the other flags, or fall back when the table could not be built
     _command_t *current_command = (_command_t *)current_cluster->command_list;
+    void *indexed_command = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_COMMAND, current_cluster->endpoint_id, current_cluster->cluster_id,
+                         command_id, &indexed_command)) {
+        // The indexed command is the first one with this id, the other one (if any) is after it in the list
+        current_command = (_command_t *)indexed_command;
+    }
     while (current_command) {
         if ((current_command->command_id == command_id) && (current_command->flags & flags)) {
             break;
@@ -1209,6 +1670,25 @@ command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags)
     return (command_t *)current_command;
 }
 
+esp_err_t get_sorted(cluster_t *cluster, uint16_t flag, command_t *const **commands, size_t *count)
+{
+    VerifyOrReturnError(cluster && commands && count, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Cluster, commands or count cannot be NULL"));
+    VerifyOrReturnError(flag == COMMAND_FLAG_ACCEPTED || flag == COMMAND_FLAG_GENERATED, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Flag must be COMMAND_FLAG_ACCEPTED or COMMAND_FLAG_GENERATED"));
+    command_table_t *table = get_table((_cluster_t *)cluster);
+    VerifyOrReturnError(table, ESP_ERR_NO_MEM);
+    _command_t **table_commands = get_table_commands(table);
+    if (flag == COMMAND_FLAG_ACCEPTED) {
+        *commands = (command_t *const *)table_commands;
+        *count = table->accepted_count;
+    } else {
+        *commands = (command_t *const *)(table_commands + table->accepted_count);
+        *count = table->generated_count;
+    }
+    return ESP_OK;
+}
+
 command_t *get_first(cluster_t *cluster)
 {
     VerifyOrReturnValue(cluster, NULL, ESP_LOGE(TAG, "Cluster cannot be NULL."));
@@ -1275,9 +1755,10 @@ event_t *create(cluster_t *cluster, uint32_t event_id)
                  cluster::get_id(cluster));
         return existing_event;
     }
+    VerifyOrReturnValue(cluster::unshare_metadata(current_cluster) == ESP_OK, NULL);
 
     /* Allocate */
-    _event_t *event = (_event_t *)esp_matter_mem_calloc(1, sizeof(_event_t));
+    _event_t *event = (_event_t *)esp_matter_mem_slab_calloc(sizeof(_event_t));
     VerifyOrReturnValue(event, NULL, ESP_LOGE(TAG, "Couldn't allocate _event_t"));
 
     /* Set */
@@ -1285,6 +1766,9 @@ event_t *create(cluster_t *cluster, uint32_t event_id)
 
     /* Add */
     SinglyLinkedList<_event_t>::append(&current_cluster->event_list, event);
+    path_index::insert(path_index::ELEMENT_KIND_EVENT, current_cluster->endpoint_id, current_cluster->cluster_id,
+                       event_id, event);
+    sealed_model::invalidate();
     return (event_t *)event;
 }
 
@@ -1292,6 +1776,11 @@ event_t *get(cluster_t *cluster, uint32_t event_id)
 {
     VerifyOrReturnValue(cluster, NULL, ESP_LOGE(TAG, "Cluster cannot be NULL."));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
+    void *indexed_event = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_EVENT, current_cluster->endpoint_id, current_cluster->cluster_id,
+                         event_id, &indexed_event)) {
+        return (event_t *)indexed_event;
+    }
     _event_t *current_event = (_event_t *)current_cluster->event_list;
     while (current_event) {
         if (current_event->event_id == event_id) {
@@ -1337,18 +1826,29 @@ cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
     cluster_t *existing_cluster = get(endpoint, cluster_id);
     if (existing_cluster) {
         _cluster_t *_existing_cluster = (_cluster_t *)existing_cluster;
+        node::count_endpoint_cluster(current_endpoint, cluster_id, flags & ~_existing_cluster->flags, true);
         _existing_cluster->flags |= flags;
+        sealed_model::invalidate();
         return existing_cluster;
     }
 
     /* Allocate */
-    _cluster_t *cluster = (_cluster_t *)esp_matter_mem_calloc(1, sizeof(_cluster_t));
+    _cluster_t *cluster = (_cluster_t *)esp_matter_mem_slab_calloc(sizeof(_cluster_t));
     if (!cluster) {
         ESP_LOGE(TAG, "Couldn't allocate _cluster_t");
         return NULL;
     }
 
     /* Set */
+    // The template clusters are never resolved by path, they do not take a slot so that they outlive the node
+    cluster->slot = k_invalid_cluster_slot;
+    if (current_endpoint->endpoint_id != chip::kInvalidEndpointId) {
+        cluster->slot = alloc_slot(cluster);
+        if (cluster->slot == k_invalid_cluster_slot) {
+            esp_matter_mem_slab_free(cluster, sizeof(_cluster_t));
+            return NULL;
+        }
+    }
     cluster->cluster_id = cluster_id;
     cluster->endpoint_id = current_endpoint->endpoint_id;
     cluster->flags = flags;
@@ -1360,9 +1860,15 @@ cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
     cluster->plugin_server_init_callback = nullptr;
     cluster->init_callback = nullptr;
     cluster->shutdown_callback = nullptr;
+    cluster->template_cluster = nullptr;
+    cluster->command_table = nullptr;
 
     /* Add */
     SinglyLinkedList<_cluster_t>::append(&current_endpoint->cluster_list, cluster);
+    path_index::insert(path_index::ELEMENT_KIND_CLUSTER, cluster->endpoint_id, cluster_id, 0, cluster);
+    node::count_endpoint_cluster(current_endpoint, cluster_id, flags, true);
+    sealed_model::invalidate();
+    endpoint_table::invalidate();
     return (cluster_t *)cluster;
 }
 
@@ -1370,23 +1876,59 @@ esp_err_t destroy(cluster_t *cluster)
 {
     VerifyOrReturnError(cluster, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster cannot be NULL"));
     _cluster_t *current_cluster = (_cluster_t *)cluster;
+    uint16_t endpoint_id = current_cluster->endpoint_id;
+    uint32_t cluster_id = current_cluster->cluster_id;
+
+    // The commands and events shared with a template belong to the template
+    bool shared_metadata = current_cluster->template_cluster != nullptr;
 
     /* Parse and delete all commands */
-    SinglyLinkedList<_command_t>::delete_list(&current_cluster->command_list);
+    _command_t *command = current_cluster->command_list;
+    while (command) {
+        _command_t *next_command = command->next;
+        path_index::remove(path_index::ELEMENT_KIND_COMMAND, endpoint_id, cluster_id, command->command_id);
+        if (!shared_metadata) {
+            esp_matter_mem_slab_free(command, sizeof(_command_t));
+        }
+        command = next_command;
+    }
+    current_cluster->command_list = nullptr;
+    command::free_table(current_cluster);
 
     /* Parse and delete all attributes */
     _attribute_base_t *attribute = current_cluster->attribute_list;
     while (attribute) {
         _attribute_base_t *next_attribute = attribute->next;
+        path_index::remove(path_index::ELEMENT_KIND_ATTRIBUTE, endpoint_id, cluster_id, attribute->attribute_id);
         attribute::destroy((attribute_t *)attribute);
         attribute = next_attribute;
     }
 
     /* Parse and delete all events */
-    SinglyLinkedList<_event_t>::delete_list(&current_cluster->event_list);
+    _event_t *event = current_cluster->event_list;
+    while (event) {
+        _event_t *next_event = event->next;
+        path_index::remove(path_index::ELEMENT_KIND_EVENT, endpoint_id, cluster_id, event->event_id);
+        if (!shared_metadata) {
+            esp_matter_mem_slab_free(event, sizeof(_event_t));
+        }
+        event = next_event;
+    }
+    current_cluster->event_list = nullptr;
+
+    // The clusters of the endpoint templates are not counted in the node
+    _endpoint_t *current_endpoint =
+        endpoint_id != chip::kInvalidEndpointId ? (_endpoint_t *)endpoint::get(endpoint_id) : nullptr;
+    if (current_endpoint) {
+        node::count_endpoint_cluster(current_endpoint, cluster_id, current_cluster->flags, false);
+    }
+    path_index::remove(path_index::ELEMENT_KIND_CLUSTER, endpoint_id, cluster_id, 0);
+    free_slot(current_cluster->slot);
+    sealed_model::invalidate();
+    endpoint_table::invalidate();
 
     /* Free */
-    esp_matter_mem_free(current_cluster);
+    esp_matter_mem_slab_free(current_cluster, sizeof(_cluster_t));
     return ESP_OK;
 }
 
@@ -1394,6 +1936,11 @@ cluster_t *get(endpoint_t *endpoint, uint32_t cluster_id)
 {
     VerifyOrReturnValue(endpoint, NULL, ESP_LOGE(TAG, "Endpoint cannot be NULL"));
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    void *indexed_cluster = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_CLUSTER, current_endpoint->endpoint_id, cluster_id, 0,
+                         &indexed_cluster)) {
+        return (cluster_t *)indexed_cluster;
+    }
     _cluster_t *current_cluster = (_cluster_t *)current_endpoint->cluster_list;
 
     while (current_cluster) {
@@ -1407,6 +1954,10 @@ cluster_t *get(endpoint_t *endpoint, uint32_t cluster_id)
 
 cluster_t *get(uint16_t endpoint_id, uint32_t cluster_id)
 {
+    void *indexed_cluster = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_CLUSTER, endpoint_id, cluster_id, 0, &indexed_cluster)) {
+        return (cluster_t *)indexed_cluster;
+    }
     endpoint_t *endpoint = endpoint::get(endpoint_id);
     return get(endpoint, cluster_id);
 }
@@ -1559,6 +2110,81 @@ shutdown_callback_t get_shutdown_callback(cluster_t *cluster)
     return current_cluster->shutdown_callback;
 }
 
+static void add_attribute_memory_usage(const _attribute_base_t *attribute_base, node::memory_usage_t *usage)
+{
+    usage->attribute_count++;
+    if (attribute_base->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
+        usage->attribute_bytes += sizeof(_attribute_base_t);
+        return;
+    }
+    const _attribute_t *attribute = (const _attribute_t *)attribute_base;
+    usage->attribute_bytes += sizeof(_attribute_t);
+    if (attribute->bounds_allocated) {
+        usage->bounds_count++;
+        usage->bounds_bytes += attribute->bounds->ops->size;
+    }
+    switch (attribute->attribute_val_type) {
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        if (attribute->attribute_val.a.b) {
+            bool null_reserve = attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+                attribute->attribute_val_type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING;
+            // The buffers restored from the NVS have no capacity yet, their size is the value size
+            uint16_t capacity = std::max(attribute->attribute_val.a.cap, attribute->attribute_val.a.s);
+            usage->value_buffer_count++;
+            usage->value_buffer_bytes += capacity + (null_reserve ? 1 : 0);
+        }
+        break;
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        if (attribute->attribute_val.a.b) {
+            usage->value_buffer_count++;
+            usage->value_buffer_bytes += attribute->attribute_val.a.s;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static size_t get_total_bytes(const node::memory_usage_t *usage)
+{
+    return usage->endpoint_bytes + usage->cluster_bytes + usage->attribute_bytes + usage->value_buffer_bytes +
+        usage->bounds_bytes + usage->command_bytes + usage->event_bytes + usage->index_bytes;
+}
+
+static void add_memory_usage(const _cluster_t *cluster, node::memory_usage_t *usage)
+{
+    usage->cluster_count++;
+    usage->cluster_bytes += sizeof(_cluster_t);
+    for (const _attribute_base_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+        add_attribute_memory_usage(attribute, usage);
+    }
+    // The commands and events shared with a template are counted with the template
+    VerifyOrReturn(!cluster->template_cluster);
+    for (const _command_t *command = cluster->command_list; command; command = command->next) {
+        usage->command_count++;
+        usage->command_bytes += sizeof(_command_t);
+    }
+    if (cluster->command_table) {
+        usage->command_bytes += command::get_table_size(cluster->command_table);
+    }
+    for (const _event_t *event = cluster->event_list; event; event = event->next) {
+        usage->event_count++;
+        usage->event_bytes += sizeof(_event_t);
+    }
+}
+
+esp_err_t get_memory_usage(cluster_t *cluster, node::memory_usage_t *usage)
+{
+    VerifyOrReturnError(cluster && usage, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Cluster or usage cannot be NULL"));
+    memset(usage, 0, sizeof(*usage));
+    add_memory_usage((_cluster_t *)cluster, usage);
+    usage->total_bytes = get_total_bytes(usage);
+    return ESP_OK;
+}
+
 } // namespace cluster
 
 namespace endpoint {
@@ -1594,6 +2220,10 @@ endpoint_t *create(node_t *node, uint8_t flags, void *priv_data)
 
     /* Add */
     SinglyLinkedList<_endpoint_t>::append(&current_node->endpoint_list, endpoint);
+    current_node->endpoint_count++;
+    path_index::insert(path_index::ELEMENT_KIND_ENDPOINT, endpoint->endpoint_id, 0, 0, endpoint);
+    sealed_model::invalidate();
+    endpoint_table::invalidate();
 
     return (endpoint_t *)endpoint;
 }
@@ -1633,6 +2263,10 @@ endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv
     } else {
         previous_endpoint->next = endpoint;
     }
+    current_node->endpoint_count++;
+    path_index::insert(path_index::ELEMENT_KIND_ENDPOINT, endpoint_id, 0, 0, endpoint);
+    sealed_model::invalidate();
+    endpoint_table::invalidate();
 
     return (endpoint_t *)endpoint;
 }
@@ -1678,6 +2312,10 @@ esp_err_t destroy(node_t *node, endpoint_t *endpoint)
     } else {
         previous_endpoint->next = current_endpoint->next;
     }
+    current_node->endpoint_count--;
+    path_index::remove(path_index::ELEMENT_KIND_ENDPOINT, current_endpoint->endpoint_id, 0, 0);
+    sealed_model::invalidate();
+    endpoint_table::invalidate();
 
     /* Free */
     if (current_endpoint->identify != NULL) {
@@ -1689,10 +2327,197 @@ esp_err_t destroy(node_t *node, endpoint_t *endpoint)
     return ESP_OK;
 }
 
+endpoint_t *create_template()
+{
+    /* Allocate */
+    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
+    VerifyOrReturnValue(endpoint, NULL, ESP_LOGE(TAG, "Couldn't allocate _endpoint_t"));
+
+    /* Set */
+    // The template is not added to the node, its elements are not indexed and its attributes are not stored
+    endpoint->endpoint_id = chip::kInvalidEndpointId;
+    endpoint->parent_endpoint_id = chip::kInvalidEndpointId;
+    endpoint->composition_pattern = EndpointCompositionPattern::kFullFamily;
+    endpoint->enabled = false;
+    return (endpoint_t *)endpoint;
+}
+
+static bool is_template_bounds(_endpoint_t *template_endpoint, uint32_t cluster_id, const _attribute_t *attribute)
+{
+    _cluster_t *template_cluster = template_endpoint->cluster_list;
+    while (template_cluster && template_cluster->cluster_id != cluster_id) {
+        template_cluster = template_cluster->next;
+    }
+    VerifyOrReturnValue(template_cluster, false);
+    for (_attribute_base_t *template_attribute = template_cluster->attribute_list; template_attribute;
+         template_attribute = template_attribute->next) {
+        if (template_attribute->attribute_id == attribute->attribute_id) {
+            VerifyOrReturnValue(!(template_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY), false);
+            return ((_attribute_t *)template_attribute)->bounds == attribute->bounds;
+        }
+    }
+    return false;
+}
+
+static bool is_template_in_use(_endpoint_t *template_endpoint)
+{
+    _node_t *current_node = (_node_t *)node::get();
+    VerifyOrReturnValue(current_node, false);
+    for (_endpoint_t *endpoint = current_node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        for (_cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+            for (_cluster_t *template_cluster = template_endpoint->cluster_list; template_cluster;
+                 template_cluster = template_cluster->next) {
+                if (cluster->template_cluster == template_cluster) {
+                    return true;
+                }
+            }
+            // The clusters which were merged into an existing cluster only share the bounds of their attributes
+            for (_attribute_base_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+                if (attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) {
+                    continue;
+                }
+                _attribute_t *current_attribute = (_attribute_t *)attribute;
+                if (current_attribute->bounds && !current_attribute->bounds_allocated &&
+                    is_template_bounds(template_endpoint, cluster->cluster_id, current_attribute)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+esp_err_t destroy_template(endpoint_t *template_endpoint)
+{
+    VerifyOrReturnError(template_endpoint, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Template endpoint cannot be NULL"));
+    _endpoint_t *current_endpoint = (_endpoint_t *)template_endpoint;
+    VerifyOrReturnError(current_endpoint->endpoint_id == chip::kInvalidEndpointId, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Endpoint 0x%04" PRIX16 " is not a template", current_endpoint->endpoint_id));
+    VerifyOrReturnError(!is_template_in_use(current_endpoint), ESP_ERR_INVALID_STATE,
+                        ESP_LOGE(TAG, "The template is still used by the endpoints of the node"));
+
+    /* Parse and delete all clusters */
+    _cluster_t *cluster = current_endpoint->cluster_list;
+    while (cluster) {
+        _cluster_t *next_cluster = cluster->next;
+        cluster::destroy((cluster_t *)cluster);
+        cluster = next_cluster;
+        current_endpoint->cluster_list = cluster;
+    }
+
+    /* Free */
+    esp_matter_mem_free(current_endpoint);
+    return ESP_OK;
+}
+
+static esp_err_t add_attribute_from_template(cluster_t *cluster, const _attribute_t *template_attribute)
+{
+    bool managed_internally = template_attribute->flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY;
+    esp_matter_attr_val_t val;
+    val.type = template_attribute->attribute_val_type;
+    uint16_t max_val_size = 0;
+    if (!managed_internally) {
+        // The template value is the default, create() copies the strings into the attribute's own buffer
+        val.val = template_attribute->attribute_val;
+        if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+            val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING || val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING) {
+            max_val_size = template_attribute->attribute_val.a.max;
+        }
+    }
+    uint16_t flags = template_attribute->flags & ~ATTRIBUTE_FLAG_MIN_MAX;
+    _attribute_t *attribute =
+        (_attribute_t *)attribute::create(cluster, template_attribute->attribute_id, flags, val, max_val_size);
+    VerifyOrReturnError(attribute, ESP_ERR_NO_MEM,
+                        ESP_LOGE(TAG, "Couldn't create attribute 0x%08" PRIX32, template_attribute->attribute_id));
+    VerifyOrReturnValue(!managed_internally, ESP_OK);
+    attribute->override_callback = template_attribute->override_callback;
+    if ((template_attribute->flags & ATTRIBUTE_FLAG_MIN_MAX) && template_attribute->bounds) {
+        // The template keeps the bounds until it is destroyed, which is refused while an endpoint still uses them
+        return attribute::set_shared_bounds((attribute_t *)attribute, template_attribute->bounds);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t add_cluster_from_template(endpoint_t *endpoint, _cluster_t *template_cluster)
+{
+    bool existing_cluster = cluster::get(endpoint, template_cluster->cluster_id) != nullptr;
+    _cluster_t *cluster =
+        (_cluster_t *)cluster::create(endpoint, template_cluster->cluster_id, template_cluster->flags);
+    VerifyOrReturnError(cluster, ESP_ERR_NO_MEM,
+                        ESP_LOGE(TAG, "Couldn't create cluster 0x%08" PRIX32, template_cluster->cluster_id));
+
+    for (_attribute_base_t *attribute = template_cluster->attribute_list; attribute; attribute = attribute->next) {
+        ESP_RETURN_ON_ERROR(add_attribute_from_template((cluster_t *)cluster, (_attribute_t *)attribute), TAG,
+                            "Couldn't add the attributes of cluster 0x%08" PRIX32, template_cluster->cluster_id);
+    }
+
+    if (existing_cluster) {
+        // Merge into the cluster which is already on the endpoint, it keeps its own commands and events
+        for (_command_t *command = template_cluster->command_list; command; command = command->next) {
+            VerifyOrReturnError(command::create((cluster_t *)cluster, command->command_id, command->flags,
+                                                command->callback),
+                                ESP_ERR_NO_MEM);
+        }
+        for (_event_t *event = template_cluster->event_list; event; event = event->next) {
+            VerifyOrReturnError(event::create((cluster_t *)cluster, event->event_id), ESP_ERR_NO_MEM);
+        }
+        return ESP_OK;
+    }
+
+    cluster->functions = template_cluster->functions;
+    cluster->plugin_server_init_callback = template_cluster->plugin_server_init_callback;
+    // The delegates hold per endpoint state, they are set with set_delegate_and_init_callback() on each endpoint
+    cluster->init_callback = template_cluster->init_callback;
+    cluster->shutdown_callback = template_cluster->shutdown_callback;
+
+    /* Share the commands and events until the cluster changes them */
+    cluster->command_list = template_cluster->command_list;
+    cluster->event_list = template_cluster->event_list;
+    cluster->template_cluster = template_cluster;
+    cluster::index_metadata(cluster);
+    sealed_model::invalidate();
+    endpoint_table::invalidate();
+    return ESP_OK;
+}
+
+esp_err_t add_from_template(endpoint_t *endpoint, endpoint_t *template_endpoint)
+{
+    VerifyOrReturnError(endpoint && template_endpoint, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Endpoint or template endpoint cannot be NULL"));
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    _endpoint_t *current_template = (_endpoint_t *)template_endpoint;
+    VerifyOrReturnError(current_template->endpoint_id == chip::kInvalidEndpointId, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Endpoint 0x%04" PRIX16 " is not a template", current_template->endpoint_id));
+    VerifyOrReturnError(current_endpoint->endpoint_id != chip::kInvalidEndpointId, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Cannot add a template to another template"));
+
+    for (_cluster_t *cluster = current_template->cluster_list; cluster; cluster = cluster->next) {
+        // The bounds are added to the template once and shared by all the endpoints created from it
+        if (cluster->add_bounds_callback) {
+            cluster->add_bounds_callback((cluster_t *)cluster);
+            cluster->add_bounds_callback = nullptr;
+        }
+    }
+    for (uint8_t i = 0; i < current_template->device_type_count; ++i) {
+        ESP_RETURN_ON_ERROR(add_device_type(endpoint, current_template->device_types[i].id,
+                                            current_template->device_types[i].version),
+                            TAG, "Couldn't add the device types of the template");
+    }
+    for (_cluster_t *cluster = current_template->cluster_list; cluster; cluster = cluster->next) {
+        ESP_RETURN_ON_ERROR(add_cluster_from_template(endpoint, cluster), TAG,
+                            "Couldn't add the clusters of the template");
+    }
+    return ESP_OK;
+}
+
 endpoint_t *get(node_t *node, uint16_t endpoint_id)
 {
     VerifyOrReturnValue(node, NULL, ESP_LOGE(TAG, "Node cannot be NULL"));
     _node_t *current_node = (_node_t *)node;
+    void *indexed_endpoint = nullptr;
+    if (path_index::find(path_index::ELEMENT_KIND_ENDPOINT, endpoint_id, 0, 0, &indexed_endpoint)) {
+        return (endpoint_t *)indexed_endpoint;
+    }
     _endpoint_t *current_endpoint = (_endpoint_t *)current_node->endpoint_list;
     while (current_endpoint) {
         if (current_endpoint->endpoint_id == endpoint_id) {
@@ -1726,13 +2551,7 @@ endpoint_t *get_next(endpoint_t *endpoint)
 uint16_t get_count(node_t *node)
 {
     VerifyOrReturnValue(node, 0, ESP_LOGE(TAG, "Node cannot be NULL"));
-    uint16_t count = 0;
-    endpoint_t *endpoint = get_first(node);
-    while (endpoint) {
-        count++;
-        endpoint = get_next(endpoint);
-    }
-    return count;
+    return ((_node_t *)node)->endpoint_count;
 }
 
 uint16_t get_id(endpoint_t *endpoint)
@@ -1831,6 +2650,34 @@ esp_err_t get_semantic_tag_at_index(endpoint_t *endpoint, size_t index,
     return ESP_OK;
 }
 
+// Answer from the cluster counters when they can, false if the clusters have to be walked
+static bool get_cluster_count_from_counters(_node_t *node, uint32_t endpoint_id, uint32_t cluster_id,
+                                            uint8_t cluster_flags, uint32_t *count)
+{
+    // A cluster can have both flags, so the counters only answer for one of them
+    VerifyOrReturnValue(cluster_flags == CLUSTER_FLAG_SERVER || cluster_flags == CLUSTER_FLAG_CLIENT, false);
+    bool server = cluster_flags == CLUSTER_FLAG_SERVER;
+    if (!is_wildcard_endpoint_id(endpoint_id)) {
+        // The specific cluster of a specific endpoint is found with the path index
+        VerifyOrReturnValue(is_wildcard_cluster_id(cluster_id), false);
+        _endpoint_t *endpoint = (_endpoint_t *)get(endpoint_id);
+        *count = endpoint && endpoint->enabled
+            ? (server ? endpoint->server_cluster_count : endpoint->client_cluster_count) : 0;
+        return true;
+    }
+    VerifyOrReturnValue(!node->cluster_counts_incomplete, false);
+    if (!is_wildcard_cluster_id(cluster_id)) {
+        const cluster_endpoint_count_t *entry = node::find_cluster_count(cluster_id, false);
+        *count = entry ? (server ? entry->server_count : entry->client_count) : 0;
+        return true;
+    }
+    *count = 0;
+    for (uint16_t i = 0; i < node->cluster_count_size; ++i) {
+        *count += server ? node->cluster_counts[i].server_count : node->cluster_counts[i].client_count;
+    }
+    return true;
+}
+
 /**
  * @brief Get the number of clusters that match the given flags
  *
@@ -1844,6 +2691,9 @@ uint32_t get_cluster_count(uint32_t endpoint_id, uint32_t cluster_id, uint8_t cl
     uint32_t count = 0;
     node_t *node = node::get();
     VerifyOrReturnValue(node, count, ESP_LOGE(TAG, "Node cannot be NULL"));
+    if (get_cluster_count_from_counters((_node_t *)node, endpoint_id, cluster_id, cluster_flags, &count)) {
+        return count;
+    }
 
     // lambda to check if cluster matches flags and return 1 if it does, 0 otherwise
     auto check_cluster_flags = [cluster_flags](const cluster_t *cluster) -> uint32_t {
@@ -1940,6 +2790,24 @@ esp_err_t set_identify(uint16_t endpoint_id, void *identify)
     return ESP_OK;
 }
 
+static void add_memory_usage(const _endpoint_t *endpoint, node::memory_usage_t *usage)
+{
+    usage->endpoint_count++;
+    usage->endpoint_bytes += sizeof(_endpoint_t);
+    for (const _cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+        cluster::add_memory_usage(cluster, usage);
+    }
+}
+
+esp_err_t get_memory_usage(endpoint_t *endpoint, node::memory_usage_t *usage)
+{
+    VerifyOrReturnError(endpoint && usage, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Endpoint or usage cannot be NULL"));
+    memset(usage, 0, sizeof(*usage));
+    add_memory_usage((_endpoint_t *)endpoint, usage);
+    usage->total_bytes = cluster::get_total_bytes(usage);
+    return ESP_OK;
+}
+
 } // namespace endpoint
 
 namespace node {
@@ -1955,9 +2823,21 @@ node_t *create_raw()
 esp_err_t destroy_raw()
 {
     VerifyOrReturnError(node, ESP_ERR_INVALID_STATE, ESP_LOGE(TAG, "NULL node cannot be destroyed"));
+    // Store the dirty non-volatile values before forgetting them
+    write_behind::flush();
     _node_t *current_node = (_node_t *)node;
+    esp_matter_mem_free(current_node->cluster_counts);
     esp_matter_mem_free(current_node);
     node = NULL;
+    path_index::reset();
+    cluster::reset_slots();
+    endpoint_table::reset();
+    report_policy::reset();
+    write_behind::reset();
+    sealed_model::unseal();
+    metadata_cache::reset();
+    attribute::end_nvs_restore();
+    attribute::reset_nvs_snapshots();
     return ESP_OK;
 }
 
@@ -1966,6 +2846,23 @@ node_t *get()
     return (node_t *)node;
 }
 
+esp_err_t seal()
+{
+    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE, ESP_LOGE(TAG, "Node cannot be NULL"));
+    return sealed_model::seal();
+}
+
+void unseal()
+{
+    sealed_model::unseal();
+    metadata_cache::reset();
+}
+
+bool is_sealed()
+{
+    return sealed_model::is_sealed();
+}
+
 esp_err_t destroy()
 {
     esp_err_t err = ESP_OK;
@@ -1974,6 +2871,8 @@ esp_err_t destroy()
 
     attribute::set_callback(nullptr);
     identification::set_callback(nullptr);
+    // Store the dirty non-volatile values with one commit before their attributes are destroyed
+    write_behind::flush();
 
     endpoint_t *current_endpoint = endpoint::get_first(current_node);
     endpoint_t *next_endpoint = nullptr;
@@ -1987,7 +2886,10 @@ esp_err_t destroy()
         current_endpoint = next_endpoint;
     }
 
-    return destroy_raw();
+    err = destroy_raw();
+    // Return the slab pages of the node to the heap, the pages which still hold template objects are kept
+    esp_matter_mem_slab_release_empty_pages();
+    return err;
 }
 
 uint32_t get_server_cluster_endpoint_count(uint32_t cluster_id)
@@ -2000,5 +2902,34 @@ uint32_t get_client_cluster_endpoint_count(uint32_t cluster_id)
     return endpoint::get_cluster_count(chip::kInvalidEndpointId, cluster_id, CLUSTER_FLAG_CLIENT);
 }
 
+esp_err_t get_cluster_endpoint_counts(uint16_t index, uint32_t *cluster_id, uint16_t *server_count,
+                                      uint16_t *client_count)
+{
+    VerifyOrReturnError(cluster_id && server_count && client_count, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "Output arguments cannot be NULL"));
+    VerifyOrReturnError(node && !node->cluster_counts_incomplete, ESP_ERR_INVALID_STATE);
+    VerifyOrReturnError(index < node->cluster_count_size, ESP_ERR_NOT_FOUND);
+    *cluster_id = node->cluster_counts[index].cluster_id;
+    *server_count = node->cluster_counts[index].server_count;
+    *client_count = node->cluster_counts[index].client_count;
+    return ESP_OK;
+}
+
+esp_err_t get_memory_usage(memory_usage_t *usage)
+{
+    VerifyOrReturnError(usage, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Usage cannot be NULL"));
+    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE, ESP_LOGE(TAG, "Node cannot be NULL"));
+    memset(usage, 0, sizeof(*usage));
+    for (const _endpoint_t *endpoint = node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        endpoint::add_memory_usage(endpoint, usage);
+    }
+    usage->index_bytes = sizeof(_node_t) + node->cluster_count_capacity * sizeof(cluster_endpoint_count_t) +
+        cluster::cluster_slot_capacity * sizeof(_cluster_t *) + path_index::get_size() + endpoint_table::get_size() +
+        sealed_model::get_size() + metadata_cache::get_size() + report_policy::get_size() + write_behind::get_size() +
+        attribute::get_nvs_snapshots_size() + nvs_stats::get_size();
+    usage->total_bytes = cluster::get_total_bytes(usage);
+    return ESP_OK;
+}
+
 } // namespace node
 } // namespace esp_matter
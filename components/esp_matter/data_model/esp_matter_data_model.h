@@ -147,6 +147,39 @@ node_t *get();
  */
 esp_err_t destroy();
 
+/** Seal node
+ *
+ * Pack the endpoint, cluster, attribute and command ids of the node into contiguous tables sorted by id, so that the
+ * data model provider can list the server clusters, attributes and commands of a path without walking the lists.
+ * The lists stay the source of truth: if endpoints, clusters, attributes, commands or events are created or
+ * destroyed while the node is sealed (for example the dynamic endpoints of a bridge), the tables are dropped and
+ * rebuilt on the next lookup.
+ *
+ * While the node is sealed, the attribute and accepted command entries handed to the Interaction Model engine are also
+ * built once per cluster and cached, so that a wildcard read or subscribe copies them at once.
+ *
+ * This is called by `esp_matter::start()` if CONFIG_ESP_MATTER_DATA_MODEL_AUTO_SEAL is enabled.
+ *
+ * @note: Call this function with the Matter stack lock held if matter is running.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t seal();
+
+/** Unseal node
+ *
+ * Free the sealed tables and the cached entries, the data model provider walks the lists again.
+ */
+void unseal();
+
+/** Check whether the node is sealed
+ *
+ * @return true if the node is sealed.
+ * @return false otherwise.
+ */
+bool is_sealed();
+
 /** Get the endpoint count for a server cluster
  *
  * Get the number of endpoints that have the given cluster ID as a server cluster.
@@ -170,6 +203,70 @@ uint32_t get_server_cluster_endpoint_count(uint32_t cluster_id);
  */
 uint32_t get_client_cluster_endpoint_count(uint32_t cluster_id);
 
+/** Get the endpoint counts of a cluster by index
+ *
+ * The node keeps the number of enabled endpoints which have each cluster, sorted by cluster ID. This reads them
+ * without walking the endpoints, for a summary of the data model.
+ *
+ * @param[in] index Index of the cluster, from 0.
+ * @param[out] cluster_id Cluster ID.
+ * @param[out] server_count Number of enabled endpoints which have the cluster as a server cluster.
+ * @param[out] client_count Number of enabled endpoints which have the cluster as a client cluster.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the index is past the last cluster.
+ * @return ESP_ERR_INVALID_STATE if the node is not created or the counts could not be kept.
+ * @return error in case of failure.
+ */
+esp_err_t get_cluster_endpoint_counts(uint16_t index, uint32_t *cluster_id, uint16_t *server_count,
+                                      uint16_t *client_count);
+
+/** Memory used by the data model
+ *
+ * The objects are counted with their size, the slab rounding and the heap overhead are not included.
+ */
+typedef struct memory_usage {
+    /** Endpoint objects */
+    uint32_t endpoint_count;
+    size_t endpoint_bytes;
+    /** Cluster objects */
+    uint32_t cluster_count;
+    size_t cluster_bytes;
+    /** Attribute objects */
+    uint32_t attribute_count;
+    size_t attribute_bytes;
+    /** Buffers of the string and array attribute values */
+    uint32_t value_buffer_count;
+    size_t value_buffer_bytes;
+    /** Attribute bounds owned by the attributes, the shared constant bounds are not counted */
+    uint32_t bounds_count;
+    size_t bounds_bytes;
+    /** Command objects, the lists shared with an endpoint template are not counted */
+    uint32_t command_count;
+    size_t command_bytes;
+    /** Event objects, the lists shared with an endpoint template are not counted */
+    uint32_t event_count;
+    size_t event_bytes;
+    /** Lookup tables of the node: cluster slots, path index, endpoint table, sealed tables and cached entries,
+     *  cluster counts and reporting policies. This is only set by `node::get_memory_usage()`. */
+    size_t index_bytes;
+    /** Sum of all the bytes above */
+    size_t total_bytes;
+} memory_usage_t;
+
+/** Get the memory used by the data model of the node
+ *
+ * This walks the whole node, it is meant to be sampled from time to time, not to be called on every update.
+ *
+ * @note: Call this function with the Matter stack lock held if matter is running.
+ *
+ * @param[out] usage Memory usage.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_memory_usage(memory_usage_t *usage);
+
 } /* node */
 
 namespace endpoint {
@@ -216,10 +313,60 @@ endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv
  */
 esp_err_t destroy(node_t *node, endpoint_t *endpoint);
 
+/** Create endpoint template
+ *
+ * This will create an endpoint template which is not added to the node. The clusters, attributes, commands and
+ * events of the template are created with the usual APIs, for example `endpoint::on_off_light::add()`. The
+ * attributes of the template are never stored in NVS.
+ *
+ * Endpoints created with `endpoint::add_from_template()` share the commands, events and attribute bounds of the
+ * template instead of allocating their own, which saves memory on nodes with many identical endpoints, like
+ * bridges. Each endpoint still has its own cluster and attribute objects, which hold its attribute values. A cluster
+ * gets its own copy of the commands and events when a command or event is added to it.
+ *
+ * The template does not belong to the node, it can be kept across `node::destroy()` and used for the next node.
+ *
+ * @return Endpoint template handle on success.
+ * @return NULL in case of failure.
+ */
+endpoint_t *create_template();
+
+/** Destroy endpoint template
+ *
+ * This will destroy the endpoint template and its clusters, attributes, commands and events. The endpoints created
+ * from the template should be destroyed first.
+ *
+ * @param[in] template_endpoint Endpoint template handle.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if an endpoint of the node still shares the template.
+ * @return error in case of failure.
+ */
+esp_err_t destroy_template(endpoint_t *template_endpoint);
+
+/** Add endpoint template
+ *
+ * This will add the device types and clusters of the endpoint template to the endpoint. A cluster and attribute
+ * object is allocated on the endpoint for each one of the template, the attributes take the values of the template as
+ * defaults. The attribute bounds and the commands and events are not copied, they point to the ones of the template.
+ * The delegates of the clusters are not copied, they should be set on each endpoint.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] template_endpoint Endpoint template handle.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t add_from_template(endpoint_t *endpoint, endpoint_t *template_endpoint);
+
 /** Get endpoint
  *
  * Get the endpoint present on the node.
  *
+ * @note: With CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX, the endpoint is looked up in the path index, which covers
+ * the node returned by `node::get()`. The `node` argument is then only checked for NULL, and the endpoints of
+ * another node are not found.
+ *
  * @param[in] node Node handle.
  * @param[in] endpoint_id Endpoint ID of the endpoint.
  *
@@ -486,6 +633,16 @@ esp_err_t disable(endpoint_t *endpoint);
  */
 bool is_enabled(endpoint_t *endpoint);
 
+/** Get the memory used by an endpoint and its clusters
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[out] usage Memory usage, `index_bytes` is 0.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_memory_usage(endpoint_t *endpoint, node::memory_usage_t *usage);
+
 } /* endpoint */
 
 namespace cluster {
@@ -803,6 +960,16 @@ initialization_callback_t get_init_callback(cluster_t *cluster);
  */
 shutdown_callback_t get_shutdown_callback(cluster_t *cluster);
 
+/** Get the memory used by a cluster and its attributes, commands and events
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[out] usage Memory usage, the endpoint and `index_bytes` fields are 0.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_memory_usage(cluster_t *cluster, node::memory_usage_t *usage);
+
 } /* cluster */
 
 namespace attribute {
@@ -936,6 +1103,10 @@ esp_err_t set_val(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_
  *
  * This API uses the DataModelProvider::ReadAttribute API to get the value of the attribute,
  * tries to read value from the supported storages, and then populates the value in esp_matter_attr_val_t.
+ * If the attribute is stored in the esp matter data model and the cluster has no AttributeAccessInterface
+ * or ServerClusterInterface, the value is copied directly from the esp matter storage.
+ *
+ * @note: For string types, the returned buffer is allocated and should be freed by the caller.
  *
  * @param[in] endpoint_id Endpoint id.
  * @param[in] cluster_id Cluster id.
@@ -1043,7 +1214,8 @@ callback_t get_override_callback(attribute_t *attribute);
  *
  * Only non-volatile attributes can be set with deferred persistence. If an attribute is configured with deferred
  * persistence, any modifications to it will be enacted in its persistent storage with a specific delay
- * (CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS)
+ * (CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS). With CONFIG_ESP_MATTER_NVS_WRITE_BEHIND, the attribute is
+ * written with the first flush of the dirty attributes after that delay.
  *
  * It could be used for the non-volatile attributes which might be changed rapidly, such as CurrentLevel in LevelControl
  * cluster.
@@ -1055,6 +1227,165 @@ callback_t get_override_callback(attribute_t *attribute);
  */
 esp_err_t set_deferred_persistence(attribute_t *attribute);
 
+/** Attribute reporting policy */
+typedef struct report_policy {
+    /** A change is reported only if it is larger than this value, 0 disables the absolute deadband */
+    float absolute_deadband;
+    /** A change is reported only if it is larger than this percentage of the last reported value, 0 disables the
+     * relative deadband */
+    float relative_deadband;
+    /** Minimum time between two reports, the last change within this time is reported when it is over */
+    uint32_t min_interval_ms;
+    /** Report the changes which cross `threshold` right away, ignoring the deadbands and the minimum interval */
+    bool report_on_threshold;
+    /** Threshold value, used if `report_on_threshold` is set */
+    float threshold;
+} report_policy_t;
+
+/** Set attribute reporting policy
+ *
+ * The attribute value is always stored as it is updated with `attribute::update()` or `attribute::report()`, the
+ * policy only decides when the change is marked as dirty for the subscriptions. The data version of the cluster
+ * changes with every new value, reported or not. The changes to and from null and the values written by the clients
+ * are always reported. This could be used for the sensor measurements which change slightly and often.
+ *
+ * The policy applies to the numeric attributes which are managed by the esp matter data model.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] policy Reporting policy, which is copied. NULL removes the policy of the attribute.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_report_policy(attribute_t *attribute, const report_policy_t *policy);
+
+/** Write-behind persistence statistics */
+typedef struct persistence_stats {
+    /** Changes of the non-volatile attributes */
+    uint32_t change_count;
+    /** Changes to an attribute which was already waiting to be written, each of them saves one NVS write */
+    uint32_t avoided_write_count;
+    /** Attribute values written to the NVS */
+    uint32_t write_count;
+    /** Flushes of the dirty attributes, each of them is one NVS commit */
+    uint32_t flush_count;
+    /** Attributes waiting to be written */
+    uint32_t dirty_count;
+} persistence_stats_t;
+
+/** Write the dirty non-volatile attributes
+ *
+ * With CONFIG_ESP_MATTER_NVS_WRITE_BEHIND, the changes of the non-volatile attributes are written to the NVS later,
+ * together. They are written before the restart and before the ICD enters the idle mode, this can be called before
+ * the other events which need the attributes to be stored, such as cutting the power.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t flush_persistence();
+
+/** Get the write-behind persistence statistics
+ *
+ * @param[out] stats Statistics, all zero when CONFIG_ESP_MATTER_NVS_WRITE_BEHIND is disabled.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_persistence_stats(persistence_stats_t *stats);
+
+/** NVS write counters of one attribute path */
+typedef struct nvs_path_stats {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    /** Values of the attribute handed to the NVS */
+    uint32_t write_count;
+    /** Bytes of these values */
+    uint32_t byte_count;
+    /** NVS commits which included a value of the attribute */
+    uint32_t commit_count;
+    /** Writes in the current one minute window */
+    uint32_t window_write_count;
+} nvs_path_stats_t;
+
+/** NVS partition statistics, the counters are kept since the boot or since `reset_nvs_stats()` */
+typedef struct nvs_partition_stats {
+    /** Entries of the NVS partition, as reported by `nvs_get_stats()` */
+    size_t used_entries;
+    size_t free_entries;
+    size_t total_entries;
+    /** Values of the non-volatile attributes handed to the NVS */
+    uint32_t write_count;
+    /** Writes of the attributes which did not fit in the per-path table */
+    uint32_t untracked_write_count;
+    /** Bytes written to the NVS, the snapshots are counted as a whole */
+    uint32_t byte_count;
+    /** NVS commits of the esp_matter_kvs namespace */
+    uint32_t commit_count;
+    /** NVS entries consumed by the writes, each entry is 32 bytes of flash */
+    uint32_t entry_write_count;
+    /** Page erases needed to reclaim the consumed entries */
+    uint32_t estimated_page_erases;
+    /** Estimated erase cycles of every page of the partition, assuming that the wear is levelled */
+    uint32_t estimated_erase_cycles;
+} nvs_partition_stats_t;
+
+/** Callback for the per-path NVS write counters
+ *
+ * @param[in] stats Counters of one attribute path.
+ * @param[in] priv_data Pointer passed to `for_each_nvs_path_stats()`.
+ */
+typedef void (*nvs_path_stats_callback_t)(const nvs_path_stats_t *stats, void *priv_data);
+
+/** Callback for the attributes which are written too often
+ *
+ * It is called, with the Matter stack lock held, the first time the writes of an attribute in a one minute window
+ * exceed CONFIG_ESP_MATTER_NVS_WRITE_RATE_LIMIT.
+ *
+ * @param[in] stats Counters of the attribute path.
+ */
+typedef void (*nvs_write_rate_callback_t)(const nvs_path_stats_t *stats);
+
+/** Get the NVS partition statistics and the write counters of the non-volatile attributes
+ *
+ * @param[out] stats Statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_nvs_partition_stats(nvs_partition_stats_t *stats);
+
+/** Call a callback with the write counters of every attribute path written to the NVS
+ *
+ * The counters are kept for the first CONFIG_ESP_MATTER_NVS_WRITE_STATS_MAX_PATHS paths which are written.
+ *
+ * @param[in] callback Callback, called with the Matter stack lock held.
+ * @param[in] priv_data Pointer passed to the callback.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_MATTER_NVS_WRITE_STATS is disabled.
+ * @return error in case of failure.
+ */
+esp_err_t for_each_nvs_path_stats(nvs_path_stats_callback_t callback, void *priv_data);
+
+/** Clear the NVS write counters
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t reset_nvs_stats();
+
+/** Set the callback for the attributes which are written too often
+ *
+ * Without a callback, a warning is logged.
+ *
+ * @param[in] callback Callback, NULL restores the warning.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_nvs_write_rate_callback(nvs_write_rate_callback_t callback);
+
 } /* attribute */
 
 namespace command {
@@ -1175,7 +1506,9 @@ callback_t get_user_callback(command_t *command);
 
 /** Set command user_callback
  *
- * Set the user_callback for the command.
+ * Set the user_callback for the command. If the command belongs to an endpoint created with
+ * `endpoint::add_from_template()`, the command is shared and the user_callback applies to all the endpoints created
+ * from the same template.
  *
  * @param[in] command Command handle.
  * @param[in] user_callback callback_t.
@@ -17,6 +17,7 @@
 #include <esp_matter.h>
 #include <esp_matter_endpoint.h>
 #include <esp_matter_icd_configuration.h>
+#include <esp_matter_nvs.h>
 
 static const char *TAG = "esp_matter_endpoint";
 
@@ -2180,6 +2181,8 @@ node_t *create(config_t *config, attribute::callback_t attribute_callback,
     /* Initialize esp-matter nvs partition */
     VerifyOrReturnValue(esp_matter_nvs_init() == ESP_OK, NULL, ESP_LOGE(TAG, "Failed to init esp-matter nvs partition"));
     VerifyOrReturnValue(node != nullptr, NULL, ESP_LOGE(TAG, "Could not create node"));
+    /* Read the non-volatile attributes of the endpoints in one NVS pass, it ends in esp_matter::start() */
+    attribute::begin_nvs_restore();
     endpoint_t *endpoint = endpoint::root_node::create(node, &(config->root_node), ENDPOINT_FLAG_NONE, priv_data);
     if (endpoint == nullptr) {
         destroy_raw();
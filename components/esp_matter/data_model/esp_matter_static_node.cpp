@@ -0,0 +1,133 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model_priv.h>
+#include <esp_matter_nvs.h>
+#include <esp_matter_static_node.h>
+#include <inttypes.h>
+#include <lib/support/CodeUtils.h>
+
+static const char *TAG = "esp_matter_static_node";
+
+namespace esp_matter {
+namespace static_node {
+
+static esp_err_t create_attribute(cluster_t *cluster, const attribute_def_t &def)
+{
+    esp_matter_attr_val_t val = def.default_val;
+    if (detail::is_string_type(val.type)) {
+        // The attribute copies the default into its own buffer, so the string can stay in flash
+        uint16_t data_size_len = (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+                                  val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING) ? 1 : 2;
+        val.val.a.b = (uint8_t *)def.default_buf;
+        val.val.a.s = def.default_buf_size;
+        val.val.a.t = (uint16_t)(def.default_buf_size + data_size_len);
+    }
+    attribute_t *attribute = attribute::create(cluster, def.id, def.flags, val, def.max_val_size);
+    VerifyOrReturnError(attribute, ESP_ERR_NO_MEM,
+                        ESP_LOGE(TAG, "Failed to create attribute 0x%08" PRIX32, def.id));
+    if (def.bounds) {
+        return attribute::set_shared_bounds(attribute, def.bounds);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t create_cluster(endpoint_t *endpoint, const cluster_def_t &def)
+{
+    cluster_t *cluster = cluster::create(endpoint, def.id, def.flags);
+    VerifyOrReturnError(cluster, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Failed to create cluster 0x%08" PRIX32, def.id));
+    if (def.function_list) {
+        cluster::add_function_list(cluster, def.function_list, def.function_flags);
+    }
+    if (def.plugin_server_init_callback) {
+        cluster::set_plugin_server_init_callback(cluster, def.plugin_server_init_callback);
+    }
+    if (def.add_bounds_callback) {
+        cluster::set_add_bounds_callback(cluster, def.add_bounds_callback);
+    }
+    for (uint16_t i = 0; i < def.attribute_count; ++i) {
+        ESP_RETURN_ON_ERROR(create_attribute(cluster, def.attributes[i]), TAG, "Failed to create attributes");
+    }
+    for (uint16_t i = 0; i < def.command_count; ++i) {
+        const command_def_t &command = def.commands[i];
+        VerifyOrReturnError(command::create(cluster, command.id, command.flags, command.callback), ESP_ERR_NO_MEM,
+                            ESP_LOGE(TAG, "Failed to create command 0x%08" PRIX32, command.id));
+    }
+    for (uint16_t i = 0; i < def.event_count; ++i) {
+        VerifyOrReturnError(event::create(cluster, def.event_ids[i]), ESP_ERR_NO_MEM,
+                            ESP_LOGE(TAG, "Failed to create event 0x%08" PRIX32, def.event_ids[i]));
+    }
+    return ESP_OK;
+}
+
+static endpoint_t *create_endpoint(node_t *node, const endpoint_def_t &def, void *priv_data)
+{
+    endpoint_t *endpoint = endpoint::create(node, def.flags, priv_data);
+    VerifyOrReturnValue(endpoint, nullptr, ESP_LOGE(TAG, "Failed to create endpoint"));
+    for (uint8_t i = 0; i < def.device_type_count; ++i) {
+        VerifyOrReturnValue(endpoint::add_device_type(endpoint, def.device_types[i].id, def.device_types[i].version) ==
+                                ESP_OK,
+                            nullptr, ESP_LOGE(TAG, "Failed to add device type 0x%08" PRIX32, def.device_types[i].id));
+    }
+    for (uint16_t i = 0; i < def.cluster_count; ++i) {
+        VerifyOrReturnValue(create_cluster(endpoint, def.clusters[i]) == ESP_OK, nullptr);
+    }
+    return endpoint;
+}
+
+node_t *create(const node_def_t *def, attribute::callback_t attribute_callback,
+               identification::callback_t identification_callback, void *priv_data)
+{
+    VerifyOrReturnValue(def && is_valid(*def), NULL, ESP_LOGE(TAG, "Invalid node definition"));
+    node_t *node = node::create_raw();
+    VerifyOrReturnValue(node != nullptr, NULL, ESP_LOGE(TAG, "Could not create node"));
+    /* Initialize esp-matter nvs partition, the non-volatile attributes are read while being created */
+    if (esp_matter_nvs_init() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to init esp-matter nvs partition");
+        node::destroy_raw();
+        return NULL;
+    }
+    /* Read the non-volatile attributes of the endpoints in one NVS pass, it ends in esp_matter::start() */
+    attribute::begin_nvs_restore();
+    uint16_t first_endpoint_id = 0;
+    for (uint16_t i = 0; i < def->endpoint_count; ++i) {
+        const endpoint_def_t &endpoint_def = def->endpoints[i];
+        endpoint_t *endpoint = create_endpoint(node, endpoint_def, priv_data);
+        if (!endpoint) {
+            node::destroy();
+            return NULL;
+        }
+        if (i == 0) {
+            first_endpoint_id = endpoint::get_id(endpoint);
+        }
+        if (endpoint_def.parent_index >= 0) {
+            // The endpoints are created with consecutive ids, so the parent id follows from its index
+            endpoint_t *parent = endpoint::get(node, first_endpoint_id + endpoint_def.parent_index);
+            if (endpoint::set_parent_endpoint(endpoint, parent) != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to set the parent of endpoint %u", endpoint::get_id(endpoint));
+                node::destroy();
+                return NULL;
+            }
+        }
+    }
+    attribute::set_callback(attribute_callback);
+    identification::set_callback(identification_callback);
+    return node;
+}
+
+} // namespace static_node
+} // namespace esp_matter
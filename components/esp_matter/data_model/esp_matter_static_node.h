@@ -0,0 +1,296 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_attribute_utils.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_identify.h>
+#include <esp_matter_typed_bounds.h>
+#include <sdkconfig.h>
+
+/** Static node definitions
+ *
+ * A static node is declared with `constexpr` tables instead of the runtime `endpoint::<device_type>::create()` calls,
+ * so that the definition is placed in flash and checked at compile time with `static_node::is_valid()`.
+ *
+ * `static_node::create()` builds the node with the usual data model APIs: every endpoint, cluster, attribute, command
+ * and event still gets its own heap object, like a node created at runtime. Only the attribute bounds and the cluster
+ * function lists are used in place from the tables, the ids, flags, default values and command callbacks are copied
+ * into the created objects.
+ *
+ * Example:
+ *
+ *     static constexpr auto k_level_bounds = attribute::make_bounds<uint8_t, true>(1, 254);
+ *     static constexpr static_node::attribute_def_t k_level_attributes[] = {
+ *         static_node::attribute(LevelControl::Attributes::CurrentLevel::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+ *                                static_node::nullable(static_node::uint8(64)), &k_level_bounds),
+ *         ...
+ *     };
+ *     ...
+ *     static constexpr static_node::node_def_t k_node = {k_endpoints, std::size(k_endpoints)};
+ *     static_assert(static_node::is_valid(k_node), "Invalid node definition");
+ *
+ *     node_t *node = static_node::create(&k_node, app_attribute_update_cb, app_identification_cb, nullptr);
+ */
+
+namespace esp_matter {
+namespace static_node {
+
+/** Attribute definition */
+typedef struct attribute_def {
+    uint32_t id;
+    uint16_t flags;
+    /** Default value. For the string types, only the type is used and the value is in `default_buf` */
+    esp_matter_attr_val_t default_val;
+    /** Default value of the string types */
+    const void *default_buf;
+    uint16_t default_buf_size;
+    /** Maximum size of the string types */
+    uint16_t max_val_size;
+    /** Bounds of the attribute made with `attribute::make_bounds()`, the attribute points to them instead of copying
+     * them */
+    const attribute::bounds_header_t *bounds;
+} attribute_def_t;
+
+/** Command definition */
+typedef struct command_def {
+    uint32_t id;
+    uint8_t flags;
+    command::callback_t callback;
+} command_def_t;
+
+/** Cluster definition */
+typedef struct cluster_def {
+    uint32_t id;
+    uint8_t flags;
+    const attribute_def_t *attributes;
+    uint16_t attribute_count;
+    const command_def_t *commands;
+    uint16_t command_count;
+    const uint32_t *event_ids;
+    uint16_t event_count;
+    const cluster::function_generic_t *function_list;
+    int function_flags;
+    cluster::plugin_server_init_callback_t plugin_server_init_callback;
+    cluster::add_bounds_callback_t add_bounds_callback;
+} cluster_def_t;
+
+/** Device type definition */
+typedef struct device_type_def {
+    uint32_t id;
+    uint8_t version;
+} device_type_def_t;
+
+/** Endpoint definition
+ *
+ * The endpoints get their ids in the order of the definitions, the first one should be the root node endpoint.
+ */
+typedef struct endpoint_def {
+    uint8_t flags;
+    const device_type_def_t *device_types;
+    uint8_t device_type_count;
+    const cluster_def_t *clusters;
+    uint16_t cluster_count;
+    /** Index of the parent endpoint in the node definition, or -1 if the endpoint has no parent */
+    int16_t parent_index;
+} endpoint_def_t;
+
+/** Node definition */
+typedef struct node_def {
+    const endpoint_def_t *endpoints;
+    uint16_t endpoint_count;
+} node_def_t;
+
+/** Attribute values
+ *
+ * These are the `constexpr` counterparts of the `esp_matter_<type>()` helpers.
+ */
+constexpr esp_matter_attr_val_t boolean(bool val) { return {ESP_MATTER_VAL_TYPE_BOOLEAN, {.b = val}}; }
+constexpr esp_matter_attr_val_t int8(int8_t val) { return {ESP_MATTER_VAL_TYPE_INT8, {.i8 = val}}; }
+constexpr esp_matter_attr_val_t uint8(uint8_t val) { return {ESP_MATTER_VAL_TYPE_UINT8, {.u8 = val}}; }
+constexpr esp_matter_attr_val_t int16(int16_t val) { return {ESP_MATTER_VAL_TYPE_INT16, {.i16 = val}}; }
+constexpr esp_matter_attr_val_t uint16(uint16_t val) { return {ESP_MATTER_VAL_TYPE_UINT16, {.u16 = val}}; }
+constexpr esp_matter_attr_val_t int32(int32_t val) { return {ESP_MATTER_VAL_TYPE_INT32, {.i32 = val}}; }
+constexpr esp_matter_attr_val_t uint32(uint32_t val) { return {ESP_MATTER_VAL_TYPE_UINT32, {.u32 = val}}; }
+constexpr esp_matter_attr_val_t int64(int64_t val) { return {ESP_MATTER_VAL_TYPE_INT64, {.i64 = val}}; }
+constexpr esp_matter_attr_val_t uint64(uint64_t val) { return {ESP_MATTER_VAL_TYPE_UINT64, {.u64 = val}}; }
+constexpr esp_matter_attr_val_t float_val(float val) { return {ESP_MATTER_VAL_TYPE_FLOAT, {.f = val}}; }
+constexpr esp_matter_attr_val_t enum8(uint8_t val) { return {ESP_MATTER_VAL_TYPE_ENUM8, {.u8 = val}}; }
+constexpr esp_matter_attr_val_t enum16(uint16_t val) { return {ESP_MATTER_VAL_TYPE_ENUM16, {.u16 = val}}; }
+constexpr esp_matter_attr_val_t bitmap8(uint8_t val) { return {ESP_MATTER_VAL_TYPE_BITMAP8, {.u8 = val}}; }
+constexpr esp_matter_attr_val_t bitmap16(uint16_t val) { return {ESP_MATTER_VAL_TYPE_BITMAP16, {.u16 = val}}; }
+constexpr esp_matter_attr_val_t bitmap32(uint32_t val) { return {ESP_MATTER_VAL_TYPE_BITMAP32, {.u32 = val}}; }
+
+/** Make the value nullable, the value itself must already be the null representation if the default is null */
+constexpr esp_matter_attr_val_t nullable(esp_matter_attr_val_t val)
+{
+    val.type = (esp_matter_val_type_t)(val.type | ESP_MATTER_VAL_NULLABLE_BASE);
+    return val;
+}
+
+/** Attribute definition of a scalar attribute */
+constexpr attribute_def_t attribute(uint32_t id, uint16_t flags, esp_matter_attr_val_t val,
+                                    const attribute::bounds_header_t *bounds = nullptr)
+{
+    return {id, flags, val, nullptr, 0, 0, bounds};
+}
+
+/** Attribute definition of a char string attribute, the default is a string literal */
+template <size_t N>
+constexpr attribute_def_t char_str_attribute(uint32_t id, uint16_t flags, const char (&val)[N], uint16_t max_val_size)
+{
+    return {id, flags, {ESP_MATTER_VAL_TYPE_CHAR_STRING, {}}, val, (uint16_t)(N - 1), max_val_size, nullptr};
+}
+
+/** Attribute definition of an octet string attribute */
+constexpr attribute_def_t octet_str_attribute(uint32_t id, uint16_t flags, const uint8_t *val, uint16_t size,
+                                              uint16_t max_val_size)
+{
+    return {id, flags, {ESP_MATTER_VAL_TYPE_OCTET_STRING, {}}, val, size, max_val_size, nullptr};
+}
+
+/** Attribute definition of an attribute which is managed internally, only its type is stored */
+constexpr attribute_def_t managed_attribute(uint32_t id, uint16_t flags, esp_matter_val_type_t type)
+{
+    return {id, (uint16_t)(flags | ATTRIBUTE_FLAG_MANAGED_INTERNALLY), {type, {}}, nullptr, 0, 0, nullptr};
+}
+
+namespace detail {
+
+constexpr bool is_string_type(esp_matter_val_type_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING;
+}
+
+constexpr bool is_valid(const attribute_def_t &attribute)
+{
+    esp_matter_val_type_t type = attribute.default_val.type;
+    if (type == ESP_MATTER_VAL_TYPE_INVALID) {
+        return false;
+    }
+    if (is_string_type(type) && !(attribute.flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) &&
+        attribute.default_buf_size > attribute.max_val_size) {
+        return false;
+    }
+    if (attribute.bounds) {
+        if ((attribute.flags & ATTRIBUTE_FLAG_MANAGED_INTERNALLY) || is_string_type(type) ||
+            type == ESP_MATTER_VAL_TYPE_ARRAY || type == ESP_MATTER_VAL_TYPE_BOOLEAN) {
+            return false;
+        }
+        if (attribute.bounds->ops != attribute::get_bounds_ops(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool is_valid(const cluster_def_t &cluster)
+{
+    if (!(cluster.flags & (CLUSTER_FLAG_SERVER | CLUSTER_FLAG_CLIENT))) {
+        return false;
+    }
+    for (uint16_t i = 0; i < cluster.attribute_count; ++i) {
+        if (!is_valid(cluster.attributes[i])) {
+            return false;
+        }
+        for (uint16_t j = 0; j < i; ++j) {
+            if (cluster.attributes[j].id == cluster.attributes[i].id) {
+                return false;
+            }
+        }
+    }
+    for (uint16_t i = 0; i < cluster.command_count; ++i) {
+        if (!(cluster.commands[i].flags & (COMMAND_FLAG_ACCEPTED | COMMAND_FLAG_GENERATED))) {
+            return false;
+        }
+    }
+    for (uint16_t i = 0; i < cluster.event_count; ++i) {
+        for (uint16_t j = 0; j < i; ++j) {
+            if (cluster.event_ids[j] == cluster.event_ids[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr bool is_valid(const endpoint_def_t &endpoint, uint16_t index)
+{
+    if (endpoint.device_type_count == 0 || endpoint.device_type_count > CONFIG_ESP_MATTER_MAX_DEVICE_TYPE_COUNT) {
+        return false;
+    }
+    // The parent must be created before its children
+    if (endpoint.parent_index >= (int16_t)index) {
+        return false;
+    }
+    for (uint16_t i = 0; i < endpoint.cluster_count; ++i) {
+        if (!is_valid(endpoint.clusters[i])) {
+            return false;
+        }
+        for (uint16_t j = 0; j < i; ++j) {
+            if (endpoint.clusters[j].id == endpoint.clusters[i].id) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+/** Check a node definition at compile time
+ *
+ * This checks that the ids are unique, the clusters and commands have a direction, the string defaults fit in their
+ * maximum size, the bounds were made for the attribute types, nullable or not, and the parents are defined before
+ * their children.
+ *
+ * @param[in] node Node definition.
+ *
+ * @return true if the definition is valid.
+ */
+constexpr bool is_valid(const node_def_t &node)
+{
+    if (node.endpoint_count == 0) {
+        return false;
+    }
+    for (uint16_t i = 0; i < node.endpoint_count; ++i) {
+        if (!detail::is_valid(node.endpoints[i], i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Create a node from a static definition
+ *
+ * This creates the node and allocates all of its endpoints, clusters, attributes, commands and events from the
+ * definition. The attributes point to the bounds of the definition, so the definition must stay valid for the
+ * lifetime of the node, it is expected to be `constexpr`.
+ *
+ * @param[in] node Node definition.
+ * @param[in] attribute_callback This callback is called for every attribute update. The callback implementation
+ * needs to handle the attribute update.
+ * @param[in] identification_callback This callback is invoked when clients interact with the Identify Cluster.
+ * @param[in] priv_data (Optional) Private data associated with the endpoints.
+ *
+ * @return Node handle on success.
+ * @return NULL in case of failure.
+ */
+node_t *create(const node_def_t *node, attribute::callback_t attribute_callback,
+               identification::callback_t identification_callback, void *priv_data = nullptr);
+
+} // namespace static_node
+} // namespace esp_matter
@@ -0,0 +1,211 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <esp_matter_data_model.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/util/attribute-storage-null-handling.h>
+
+/** Typed attribute bounds
+ *
+ * The bounds of an attribute are stored in the size of its value type, with the operations of that type. The
+ * operations are picked once when the bounds are set, so checking a written value is a single indirect call.
+ *
+ * The bounds which do not depend on other attribute values can be defined as constexpr tables with `make_bounds()`
+ * and shared by all the attributes with `set_shared_bounds()`.
+ */
+
+namespace esp_matter {
+namespace attribute {
+
+struct bounds_ops;
+
+/** Common header of the typed bounds, followed by the min and max values */
+typedef struct bounds_header {
+    const struct bounds_ops *ops;
+} bounds_header_t;
+
+template <typename T>
+struct typed_bounds : bounds_header_t {
+    T min;
+    T max;
+};
+
+/** Operations on the typed bounds of one value type */
+typedef struct bounds_ops {
+    /** Return 0 if val is in the bounds or null, 1 if it is more than max, -1 if it is less than min */
+    int (*compare)(const bounds_header_t *bounds, const esp_matter_val_t &val);
+    /** Write min and max to the esp_matter_val_t members of the value type */
+    void (*get)(const bounds_header_t *bounds, esp_matter_val_t *min, esp_matter_val_t *max);
+    /** Read min and max from the esp_matter_val_t members of the value type */
+    void (*set)(bounds_header_t *bounds, const esp_matter_val_t &min, const esp_matter_val_t &max);
+    /** Size of typed_bounds<T> */
+    size_t size;
+} bounds_ops_t;
+
+namespace detail {
+
+template <typename T>
+T get_member(const esp_matter_val_t &val);
+template <typename T>
+void set_member(esp_matter_val_t &val, T value);
+
+#define ESP_MATTER_BOUNDS_MEMBER(type, member)                                                                       \
+    template <>                                                                                                      \
+    inline type get_member<type>(const esp_matter_val_t &val)                                                        \
+    {                                                                                                                \
+        return val.member;                                                                                           \
+    }                                                                                                                \
+    template <>                                                                                                      \
+    inline void set_member<type>(esp_matter_val_t & val, type value)                                                 \
+    {                                                                                                                \
+        val.member = value;                                                                                          \
+    }
+
+ESP_MATTER_BOUNDS_MEMBER(uint8_t, u8)
+ESP_MATTER_BOUNDS_MEMBER(uint16_t, u16)
+ESP_MATTER_BOUNDS_MEMBER(uint32_t, u32)
+ESP_MATTER_BOUNDS_MEMBER(uint64_t, u64)
+ESP_MATTER_BOUNDS_MEMBER(int8_t, i8)
+ESP_MATTER_BOUNDS_MEMBER(int16_t, i16)
+ESP_MATTER_BOUNDS_MEMBER(int32_t, i32)
+ESP_MATTER_BOUNDS_MEMBER(int64_t, i64)
+ESP_MATTER_BOUNDS_MEMBER(float, f)
+
+#undef ESP_MATTER_BOUNDS_MEMBER
+
+template <typename T, bool nullable>
+int compare(const bounds_header_t *bounds, const esp_matter_val_t &val)
+{
+    const typed_bounds<T> *typed = static_cast<const typed_bounds<T> *>(bounds);
+    T value = get_member<T>(val);
+    if (nullable && chip::app::NumericAttributeTraits<T>::IsNullValue(value)) {
+        return 0;
+    }
+    return value < typed->min ? -1 : (value > typed->max ? 1 : 0);
+}
+
+template <typename T>
+void get(const bounds_header_t *bounds, esp_matter_val_t *min, esp_matter_val_t *max)
+{
+    const typed_bounds<T> *typed = static_cast<const typed_bounds<T> *>(bounds);
+    set_member<T>(*min, typed->min);
+    set_member<T>(*max, typed->max);
+}
+
+template <typename T>
+void set(bounds_header_t *bounds, const esp_matter_val_t &min, const esp_matter_val_t &max)
+{
+    typed_bounds<T> *typed = static_cast<typed_bounds<T> *>(bounds);
+    typed->min = get_member<T>(min);
+    typed->max = get_member<T>(max);
+}
+
+} // namespace detail
+
+template <typename T, bool nullable>
+inline constexpr bounds_ops_t k_bounds_ops = {detail::compare<T, nullable>, detail::get<T>, detail::set<T>,
+                                              sizeof(typed_bounds<T>)};
+
+/** Make constexpr bounds
+ *
+ * T is the C type of the value member, for example uint8_t for the uint8, enum8 and bitmap8 attributes, and nullable
+ * tells whether the attribute type is nullable.
+ */
+template <typename T, bool nullable = false>
+constexpr typed_bounds<T> make_bounds(T min, T max)
+{
+    return {{&k_bounds_ops<T, nullable>}, min, max};
+}
+
+/** Get the bounds operations of a value type
+ *
+ * This is constexpr so that the static node definitions can check their bounds at compile time.
+ *
+ * @param[in] type Attribute value type.
+ *
+ * @return Bounds operations, NULL if bounds cannot be set for the type.
+ */
+constexpr const bounds_ops_t *get_bounds_ops(esp_matter_val_type_t type)
+{
+    switch (type) {
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        return &k_bounds_ops<uint8_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        return &k_bounds_ops<uint8_t, true>;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        return &k_bounds_ops<uint16_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        return &k_bounds_ops<uint16_t, true>;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+        return &k_bounds_ops<uint32_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        return &k_bounds_ops<uint32_t, true>;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        return &k_bounds_ops<uint64_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64:
+        return &k_bounds_ops<uint64_t, true>;
+    case ESP_MATTER_VAL_TYPE_INT8:
+        return &k_bounds_ops<int8_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        return &k_bounds_ops<int8_t, true>;
+    case ESP_MATTER_VAL_TYPE_INT16:
+        return &k_bounds_ops<int16_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        return &k_bounds_ops<int16_t, true>;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        return &k_bounds_ops<int32_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        return &k_bounds_ops<int32_t, true>;
+    case ESP_MATTER_VAL_TYPE_INT64:
+        return &k_bounds_ops<int64_t, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64:
+        return &k_bounds_ops<int64_t, true>;
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+        return &k_bounds_ops<float, false>;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+        return &k_bounds_ops<float, true>;
+    default:
+        return nullptr;
+    }
+}
+
+/** Set bounds which are shared by several attributes without copying them
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] bounds Bounds made with `make_bounds()`, which must stay valid for the lifetime of the attribute.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the bounds do not match the attribute value type.
+ * @return error in case of failure.
+ */
+esp_err_t set_shared_bounds(attribute_t *attribute, const bounds_header_t *bounds);
+
+} // namespace attribute
+} // namespace esp_matter
@@ -25,6 +25,31 @@ namespace esp_matter {
 namespace command {
 void dispatch_single_cluster_command(const chip::app::ConcreteCommandPath &command_path, chip::TLV::TLVReader &tlv_data,
                                      void *opaque_ptr);
+
+/** Dispatch a command whose path was already resolved by the caller
+ *
+ * @param[in] command Accepted command of the path, NULL if the cluster does not accept the command.
+ * @param[in] command_path Command path.
+ * @param[in] tlv_data Command fields.
+ * @param[in] opaque_ptr Command handler.
+ */
+void dispatch_single_cluster_command(command_t *command, const chip::app::ConcreteCommandPath &command_path,
+                                     chip::TLV::TLVReader &tlv_data, void *opaque_ptr);
+
+/** Get the commands of a cluster which have a flag, sorted by id
+ *
+ * The sorted table is built on the first call and kept until a command is added to the cluster.
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[in] flag COMMAND_FLAG_ACCEPTED or COMMAND_FLAG_GENERATED.
+ * @param[out] commands Command handles sorted by id.
+ * @param[out] count Number of commands.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if the table could not be built, the caller should walk the command list instead.
+ * @return error in case of failure.
+ */
+esp_err_t get_sorted(cluster_t *cluster, uint16_t flag, command_t *const **commands, size_t *count);
 } // command
 
 namespace node {
@@ -52,6 +77,18 @@ namespace attribute {
  */
 esp_err_t get_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val);
 
+/** Check the attribute value before setting it in the esp-matter storage
+ *
+ * This checks the value type, the bounds and the string length, without changing the attribute.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`.
+ *
+ * @return ESP_OK if set_val_internal() would accept the value.
+ * @return error otherwise.
+ */
+esp_err_t check_val_internal(attribute_t *attribute, const esp_matter_attr_val_t *val);
+
 /** Set the attribute value in the esp-matter storage
  *
  * @param[in] attribute Attribute handle.
@@ -63,6 +100,65 @@ esp_err_t get_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val);
  */
 esp_err_t set_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_callbacks = true);
 
+/** Check the attribute value and call the `PRE_UPDATE` callback, without changing the attribute
+ *
+ * This is the first half of `set_val_internal()`, the value is then set with `set_prepared_val_internal()`.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`.
+ *
+ * @return ESP_OK if the value can be set.
+ * @return ESP_ERR_NOT_FINISHED if the value is not changed.
+ * @return error if the value is invalid or the `PRE_UPDATE` callback rejects it.
+ */
+esp_err_t pre_update_internal(attribute_t *attribute, esp_matter_attr_val_t *val);
+
+/** Set an attribute value accepted by `pre_update_internal()` in the esp-matter storage
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`.
+ * @param[in] call_callbacks Whether to call the attribute change post callbacks.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_prepared_val_internal(attribute_t *attribute, esp_matter_attr_val_t *val, bool call_callbacks = true);
+
+/** Update the attribute value, as `attribute::update()` does, for an attribute already looked up by the caller
+ *
+ * The data version of the cluster changes with every new value. The reporting policy of the attribute only decides
+ * whether the change is reported now.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] endpoint_id Endpoint id of the attribute.
+ * @param[in] cluster_id Cluster id of the attribute.
+ * @param[in] attribute_id Attribute id.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`. Use appropriate elements as per the value type.
+ * @param[in] apply_report_policy Whether the reporting policy of the attribute applies. The client writes are always
+ * reported.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t update_internal(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                          esp_matter_attr_val_t *val, bool apply_report_policy = true);
+
+/** Check whether a reporting policy is set for the attribute
+ *
+ * @param[in] attribute Attribute handle.
+ *
+ * @return true if `attribute::set_report_policy()` set a policy for the attribute.
+ */
+bool has_report_policy(attribute_t *attribute);
+
+/** Check whether the attribute value is null
+ *
+ * @param[in] val Pointer to `esp_matter_attr_val_t`.
+ *
+ * @return true if the value type is nullable and the value is null.
+ */
+bool val_is_null(esp_matter_attr_val_t *val);
+
 } // namespace attribute
 
 } // namespace esp_matter
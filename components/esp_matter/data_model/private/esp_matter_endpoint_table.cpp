@@ -0,0 +1,286 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_endpoint_table.h>
+#include <esp_matter_mem.h>
+#include <lib/support/CodeUtils.h>
+#include <string.h>
+
+namespace esp_matter {
+namespace endpoint_table {
+
+static const char *TAG = "endpoint_table";
+
+static constexpr uint16_t k_bits_per_word = 32;
+
+// All the arrays live in one allocation, which is kept when the table is rebuilt if it is large enough
+typedef struct table {
+    uint16_t endpoint_count;
+    uint16_t cluster_count;
+    uint16_t word_count;
+    size_t size;
+    endpoint_t **endpoints;
+    /* Sorted cluster ids, the bitmap of cluster i is cluster_bits[i * word_count, (i + 1) * word_count) */
+    uint32_t *cluster_ids;
+    uint32_t *cluster_bits;
+    uint32_t *enabled_bits;
+    /* Sorted endpoint ids and their index in the endpoint list */
+    uint16_t *endpoint_ids;
+    uint16_t *endpoint_indexes;
+} table_t;
+
+static table_t *s_table = nullptr;
+static bool s_valid = false;
+// Set when building the table failed, so that the lookups do not retry until the node changes
+static bool s_build_failed = false;
+
+template <typename T>
+static T *carve(uint8_t *&cursor, size_t count)
+{
+    T *array = reinterpret_cast<T *>(cursor);
+    cursor += count * sizeof(T);
+    return array;
+}
+
+static bool find_cluster(const table_t *table, uint32_t cluster_id, uint16_t *index)
+{
+    uint16_t low = 0, high = table->cluster_count;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (table->cluster_ids[mid] < cluster_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    VerifyOrReturnValue(low < table->cluster_count && table->cluster_ids[low] == cluster_id, false);
+    *index = low;
+    return true;
+}
+
+static bool find_endpoint(const table_t *table, uint16_t endpoint_id, uint16_t *index)
+{
+    uint16_t low = 0, high = table->endpoint_count;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (table->endpoint_ids[mid] < endpoint_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    VerifyOrReturnValue(low < table->endpoint_count && table->endpoint_ids[low] == endpoint_id, false);
+    *index = table->endpoint_indexes[low];
+    return true;
+}
+
+static void set_bit(uint32_t *bits, uint16_t index)
+{
+    bits[index / k_bits_per_word] |= 1UL << (index % k_bits_per_word);
+}
+
+static void clear_bit(uint32_t *bits, uint16_t index)
+{
+    bits[index / k_bits_per_word] &= ~(1UL << (index % k_bits_per_word));
+}
+
+static uint16_t collect_cluster_ids(node_t *node, uint32_t *cluster_ids)
+{
+    // Insert the ids in order and skip the duplicates, most endpoints share the same few clusters
+    uint16_t count = 0;
+    for (endpoint_t *ep = endpoint::get_first(node); ep; ep = endpoint::get_next(ep)) {
+        for (cluster_t *cl = cluster::get_first(ep); cl; cl = cluster::get_next(cl)) {
+            uint32_t cluster_id = cluster::get_id(cl);
+            uint16_t i = count;
+            for (; i > 0 && cluster_ids[i - 1] > cluster_id; --i) {
+            }
+            if (i > 0 && cluster_ids[i - 1] == cluster_id) {
+                continue;
+            }
+            for (uint16_t j = count; j > i; --j) {
+                cluster_ids[j] = cluster_ids[j - 1];
+            }
+            cluster_ids[i] = cluster_id;
+            count++;
+        }
+    }
+    return count;
+}
+
+static esp_err_t build()
+{
+    node_t *node = node::get();
+    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE);
+
+    size_t endpoint_count = 0, cluster_count = 0;
+    for (endpoint_t *ep = endpoint::get_first(node); ep; ep = endpoint::get_next(ep)) {
+        endpoint_count++;
+        for (cluster_t *cl = cluster::get_first(ep); cl; cl = cluster::get_next(cl)) {
+            cluster_count++;
+        }
+    }
+    uint32_t *cluster_ids = (uint32_t *)esp_matter_mem_calloc(cluster_count ? cluster_count : 1, sizeof(uint32_t));
+    VerifyOrReturnError(cluster_ids, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Couldn't allocate the endpoint table"));
+    uint16_t distinct_count = collect_cluster_ids(node, cluster_ids);
+    uint16_t word_count = (endpoint_count + k_bits_per_word - 1) / k_bits_per_word;
+
+    // Pointers first and the narrower arrays last, so that every array is naturally aligned
+    size_t size = sizeof(table_t) + endpoint_count * sizeof(endpoint_t *) +
+        (distinct_count + (distinct_count + 1) * word_count) * sizeof(uint32_t) +
+        2 * endpoint_count * sizeof(uint16_t);
+    table_t *table = s_table;
+    if (!table || table->size < size) {
+        table = (table_t *)esp_matter_mem_realloc(s_table, size);
+        if (!table) {
+            esp_matter_mem_free(cluster_ids);
+            ESP_LOGE(TAG, "Couldn't allocate the endpoint table");
+            return ESP_ERR_NO_MEM;
+        }
+        s_table = table;
+        table->size = size;
+    }
+    uint8_t *cursor = (uint8_t *)(table + 1);
+    table->endpoint_count = endpoint_count;
+    table->cluster_count = distinct_count;
+    table->word_count = word_count;
+    table->endpoints = carve<endpoint_t *>(cursor, endpoint_count);
+    table->cluster_ids = carve<uint32_t>(cursor, distinct_count);
+    table->cluster_bits = carve<uint32_t>(cursor, distinct_count * word_count);
+    table->enabled_bits = carve<uint32_t>(cursor, word_count);
+    table->endpoint_ids = carve<uint16_t>(cursor, endpoint_count);
+    table->endpoint_indexes = carve<uint16_t>(cursor, endpoint_count);
+    memcpy(table->cluster_ids, cluster_ids, distinct_count * sizeof(uint32_t));
+    memset(table->cluster_bits, 0, distinct_count * word_count * sizeof(uint32_t));
+    memset(table->enabled_bits, 0, word_count * sizeof(uint32_t));
+    esp_matter_mem_free(cluster_ids);
+
+    uint16_t index = 0;
+    for (endpoint_t *ep = endpoint::get_first(node); ep; ep = endpoint::get_next(ep), ++index) {
+        table->endpoints[index] = ep;
+        if (endpoint::is_enabled(ep)) {
+            set_bit(table->enabled_bits, index);
+        }
+        for (cluster_t *cl = cluster::get_first(ep); cl; cl = cluster::get_next(cl)) {
+            uint16_t cluster_index;
+            if (find_cluster(table, cluster::get_id(cl), &cluster_index)) {
+                set_bit(&table->cluster_bits[cluster_index * word_count], index);
+            }
+        }
+        /* The endpoints are mostly created in id order, insertion sort is the cheapest here */
+        uint16_t endpoint_id = endpoint::get_id(ep);
+        uint16_t i = index;
+        for (; i > 0 && table->endpoint_ids[i - 1] > endpoint_id; --i) {
+            table->endpoint_ids[i] = table->endpoint_ids[i - 1];
+            table->endpoint_indexes[i] = table->endpoint_indexes[i - 1];
+        }
+        table->endpoint_ids[i] = endpoint_id;
+        table->endpoint_indexes[i] = index;
+    }
+    ESP_LOGD(TAG, "Indexed %u endpoints and %u cluster ids in %u bytes", (unsigned)endpoint_count,
+             (unsigned)distinct_count, (unsigned)size);
+    return ESP_OK;
+}
+
+static const table_t *get_table()
+{
+    if (!s_valid && !s_build_failed) {
+        s_build_failed = build() != ESP_OK;
+        s_valid = !s_build_failed;
+    }
+    return s_valid ? s_table : nullptr;
+}
+
+bool get_at(uint16_t index, endpoint_t **endpoint)
+{
+    const table_t *table = get_table();
+    VerifyOrReturnValue(table, false);
+    *endpoint = index < table->endpoint_count ? table->endpoints[index] : nullptr;
+    return true;
+}
+
+bool find_next(uint32_t cluster_id, uint16_t start, uint16_t *index)
+{
+    const table_t *table = get_table();
+    VerifyOrReturnValue(table, false);
+    *index = table->endpoint_count;
+    uint16_t cluster_index;
+    VerifyOrReturnValue(start < table->endpoint_count && find_cluster(table, cluster_id, &cluster_index), true);
+
+    const uint32_t *cluster_bits = &table->cluster_bits[cluster_index * table->word_count];
+    uint16_t word = start / k_bits_per_word;
+    uint32_t mask = UINT32_MAX << (start % k_bits_per_word);
+    for (; word < table->word_count; ++word, mask = UINT32_MAX) {
+        uint32_t bits = cluster_bits[word] & table->enabled_bits[word] & mask;
+        if (bits) {
+            *index = word * k_bits_per_word + __builtin_ctz(bits);
+            break;
+        }
+    }
+    return true;
+}
+
+bool get_cluster_rank(uint16_t endpoint_id, uint32_t cluster_id, uint16_t *rank)
+{
+    const table_t *table = get_table();
+    VerifyOrReturnValue(table, false);
+    *rank = 0xFFFF;
+    uint16_t index, cluster_index;
+    VerifyOrReturnValue(find_endpoint(table, endpoint_id, &index) && find_cluster(table, cluster_id, &cluster_index),
+                        true);
+
+    const uint32_t *cluster_bits = &table->cluster_bits[cluster_index * table->word_count];
+    uint16_t word = index / k_bits_per_word;
+    uint32_t bit = 1UL << (index % k_bits_per_word);
+    VerifyOrReturnValue(cluster_bits[word] & bit, true);
+    uint16_t count = __builtin_popcount(cluster_bits[word] & (bit - 1));
+    for (uint16_t i = 0; i < word; ++i) {
+        count += __builtin_popcount(cluster_bits[i]);
+    }
+    *rank = count;
+    return true;
+}
+
+void set_enabled(uint16_t endpoint_id, bool enabled)
+{
+    VerifyOrReturn(s_valid);
+    uint16_t index;
+    VerifyOrReturn(find_endpoint(s_table, endpoint_id, &index));
+    if (enabled) {
+        set_bit(s_table->enabled_bits, index);
+    } else {
+        clear_bit(s_table->enabled_bits, index);
+    }
+}
+
+void invalidate()
+{
+    s_valid = false;
+    s_build_failed = false;
+}
+
+void reset()
+{
+    invalidate();
+    esp_matter_mem_free(s_table);
+    s_table = nullptr;
+}
+
+size_t get_size()
+{
+    return s_table ? s_table->size : 0;
+}
+
+} // namespace endpoint_table
+} // namespace esp_matter
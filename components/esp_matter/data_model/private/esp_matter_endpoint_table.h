@@ -0,0 +1,80 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_data_model.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Endpoint index table
+ *
+ * The ember compatibility functions address the endpoints by their index in the endpoint list of the node. This
+ * table keeps the endpoint handles in list order, the enabled endpoints as a bitmap and, for each cluster id, the
+ * bitmap of the endpoints which have the cluster. The table is built on the first lookup after the node changes
+ * shape, and the enabled bitmap follows `endpoint::enable()` and `endpoint::disable()`.
+ *
+ * The lookups return false when the table cannot be built, the callers should then walk the endpoint list.
+ */
+
+namespace esp_matter {
+namespace endpoint_table {
+
+/** Get the endpoint at an index of the endpoint list
+ *
+ * @param[in] index Endpoint index.
+ * @param[out] endpoint Endpoint handle, NULL if the index is out of range.
+ *
+ * @return true if the table answered.
+ */
+bool get_at(uint16_t index, endpoint_t **endpoint);
+
+/** Find the next enabled endpoint which has a cluster
+ *
+ * @param[in] cluster_id Cluster id.
+ * @param[in] start Index of the first endpoint to check.
+ * @param[out] index Index of the matching endpoint, the number of endpoints if there is none.
+ *
+ * @return true if the table answered.
+ */
+bool find_next(uint32_t cluster_id, uint16_t start, uint16_t *index);
+
+/** Get the number of endpoints which have a cluster and are before an endpoint in the endpoint list
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[out] rank Number of endpoints, 0xFFFF if the endpoint does not exist or does not have the cluster.
+ *
+ * @return true if the table answered.
+ */
+bool get_cluster_rank(uint16_t endpoint_id, uint32_t cluster_id, uint16_t *rank);
+
+/** Update the enabled bitmap, the data model calls this when an endpoint is enabled or disabled
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] enabled Whether the endpoint is enabled.
+ */
+void set_enabled(uint16_t endpoint_id, bool enabled);
+
+/** Mark the table as stale, the data model calls this when an endpoint or a cluster is created or destroyed */
+void invalidate();
+
+/** Free the table, this is called when the node is destroyed */
+void reset();
+
+/** Get the bytes used by the table */
+size_t get_size();
+
+} // namespace endpoint_table
+} // namespace esp_matter
@@ -0,0 +1,183 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_data_model.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_metadata_cache.h>
+#include <new>
+
+#include <access/Privilege.h>
+#include <app-common/zap-generated/cluster-objects.h>
+#include <clusters/shared/GlobalIds.h>
+#include <lib/support/CodeUtils.h>
+#include <zap-generated/access.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace esp_matter {
+namespace metadata_cache {
+
+static const char *TAG = "metadata_cache";
+
+static constexpr size_t k_global_attributes_count = 3;
+
+enum built_flags : uint8_t {
+    BUILT_ATTRIBUTES = 0x01,
+    BUILT_ACCEPTED_COMMANDS = 0x02,
+};
+
+// The entries live in one allocation. The attribute entries of cluster i start at
+// `first_attribute + i * k_global_attributes_count`, the accepted command entries at `first_accepted_command`.
+typedef struct cache {
+    uint32_t generation;
+    size_t size;
+    DataModel::AttributeEntry *attributes;
+    DataModel::AcceptedCommandEntry *accepted_commands;
+    uint8_t *built;
+} cache_t;
+
+static cache_t *s_cache = nullptr;
+// Generation of the sealed tables for which the allocation failed, so that the lookups do not retry
+static uint32_t s_failed_generation = 0;
+
+static size_t align_up(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+static cache_t *get_cache()
+{
+    sealed_model::layout_t layout;
+    VerifyOrReturnValue(sealed_model::get_layout(&layout), nullptr);
+    if (s_cache && s_cache->generation == layout.generation) {
+        return s_cache;
+    }
+    reset();
+    VerifyOrReturnValue(s_failed_generation != layout.generation, nullptr);
+
+    size_t attributes_offset = align_up(sizeof(cache_t), alignof(DataModel::AttributeEntry));
+    size_t accepted_offset = align_up(attributes_offset + (layout.attribute_count + layout.cluster_count *
+                                      k_global_attributes_count) * sizeof(DataModel::AttributeEntry),
+                                      alignof(DataModel::AcceptedCommandEntry));
+    size_t built_offset = accepted_offset + layout.accepted_command_count * sizeof(DataModel::AcceptedCommandEntry);
+    size_t size = built_offset + layout.cluster_count * sizeof(uint8_t);
+    uint8_t *buffer = (uint8_t *)esp_matter_mem_calloc(1, size);
+    if (!buffer) {
+        s_failed_generation = layout.generation;
+        ESP_LOGE(TAG, "Couldn't allocate the metadata cache");
+        return nullptr;
+    }
+    s_cache = (cache_t *)buffer;
+    s_cache->generation = layout.generation;
+    s_cache->size = size;
+    s_cache->attributes = reinterpret_cast<DataModel::AttributeEntry *>(buffer + attributes_offset);
+    s_cache->accepted_commands = reinterpret_cast<DataModel::AcceptedCommandEntry *>(buffer + accepted_offset);
+    s_cache->built = buffer + built_offset;
+    return s_cache;
+}
+
+DataModel::AttributeEntry make_attribute_entry(ClusterId cluster_id, AttributeId attribute_id, uint16_t flags)
+{
+    chip::BitFlags<DataModel::AttributeQualityFlags> attr_quality_flags;
+    // TODO Array
+    attr_quality_flags.Set(DataModel::AttributeQualityFlags::kTimed, flags & ATTRIBUTE_FLAG_MUST_USE_TIMED_WRITE);
+    chip::Access::Privilege read_privilege = MatterGetAccessPrivilegeForReadAttribute(cluster_id, attribute_id);
+    auto write_privilege = (flags & ATTRIBUTE_FLAG_WRITABLE)
+        ? std::make_optional(MatterGetAccessPrivilegeForWriteAttribute(cluster_id, attribute_id))
+        : std::nullopt;
+    return DataModel::AttributeEntry(attribute_id, attr_quality_flags, read_privilege, write_privilege);
+}
+
+DataModel::AcceptedCommandEntry make_accepted_command_entry(ClusterId cluster_id, CommandId command_id)
+{
+    BitMask<DataModel::CommandQualityFlags> quality_flags;
+    quality_flags.Set(DataModel::CommandQualityFlags::kFabricScoped, CommandIsFabricScoped(cluster_id, command_id))
+        .Set(DataModel::CommandQualityFlags::kTimed, CommandNeedsTimedInvoke(cluster_id, command_id))
+        .Set(DataModel::CommandQualityFlags::kLargeMessage, CommandHasLargePayload(cluster_id, command_id));
+    return DataModel::AcceptedCommandEntry(command_id, quality_flags,
+                                           MatterGetAccessPrivilegeForInvokeCommand(cluster_id, command_id));
+}
+
+Span<const DataModel::AttributeEntry> get_global_attributes()
+{
+    static const DataModel::AttributeEntry global_attributes[k_global_attributes_count] = {
+        DataModel::AttributeEntry(Clusters::Globals::Attributes::AttributeList::Id,
+                                  chip::BitFlags<DataModel::AttributeQualityFlags>(), chip::Access::Privilege::kView,
+                                  std::nullopt),
+        DataModel::AttributeEntry(Clusters::Globals::Attributes::AcceptedCommandList::Id,
+                                  chip::BitFlags<DataModel::AttributeQualityFlags>(), chip::Access::Privilege::kView,
+                                  std::nullopt),
+        DataModel::AttributeEntry(Clusters::Globals::Attributes::GeneratedCommandList::Id,
+                                  chip::BitFlags<DataModel::AttributeQualityFlags>(), chip::Access::Privilege::kView,
+                                  std::nullopt),
+    };
+    return Span<const DataModel::AttributeEntry>(global_attributes, k_global_attributes_count);
+}
+
+bool get_attributes(ClusterId cluster_id, const sealed_model::cluster_view_t &view,
+                    Span<const DataModel::AttributeEntry> *entries)
+{
+    cache_t *cache = get_cache();
+    VerifyOrReturnValue(cache, false);
+    DataModel::AttributeEntry *first =
+        &cache->attributes[view.first_attribute + view.index * k_global_attributes_count];
+    if (!(cache->built[view.index] & BUILT_ATTRIBUTES)) {
+        for (size_t index = 0; index < view.attribute_count; ++index) {
+            new (&first[index])
+                DataModel::AttributeEntry(make_attribute_entry(cluster_id, view.attribute_ids[index],
+                                                               view.attribute_flags[index]));
+        }
+        Span<const DataModel::AttributeEntry> globals = get_global_attributes();
+        for (size_t index = 0; index < globals.size(); ++index) {
+            new (&first[view.attribute_count + index]) DataModel::AttributeEntry(globals[index]);
+        }
+        cache->built[view.index] |= BUILT_ATTRIBUTES;
+    }
+    *entries = Span<const DataModel::AttributeEntry>(first, view.attribute_count + k_global_attributes_count);
+    return true;
+}
+
+bool get_accepted_commands(ClusterId cluster_id, const sealed_model::cluster_view_t &view,
+                           Span<const DataModel::AcceptedCommandEntry> *entries)
+{
+    cache_t *cache = get_cache();
+    VerifyOrReturnValue(cache, false);
+    DataModel::AcceptedCommandEntry *first = &cache->accepted_commands[view.first_accepted_command];
+    if (!(cache->built[view.index] & BUILT_ACCEPTED_COMMANDS)) {
+        for (size_t index = 0; index < view.accepted_command_count; ++index) {
+            new (&first[index])
+                DataModel::AcceptedCommandEntry(make_accepted_command_entry(cluster_id, view.accepted_command_ids[index]));
+        }
+        cache->built[view.index] |= BUILT_ACCEPTED_COMMANDS;
+    }
+    *entries = Span<const DataModel::AcceptedCommandEntry>(first, view.accepted_command_count);
+    return true;
+}
+
+void reset()
+{
+    // The entries are trivially destructible, the buffer is freed as is
+    esp_matter_mem_free(s_cache);
+    s_cache = nullptr;
+}
+
+size_t get_size()
+{
+    return s_cache ? s_cache->size : 0;
+}
+
+} // namespace metadata_cache
+} // namespace esp_matter
@@ -0,0 +1,85 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/data-model-provider/MetadataTypes.h>
+#include <esp_matter_sealed_model.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Metadata entries of the sealed data model
+ *
+ * The data model provider hands the attribute and accepted command entries of every cluster to the Interaction Model
+ * engine on each wildcard read or subscribe. Building an entry looks up the access privileges and the command quality
+ * flags in the generated tables, so the entries of a cluster are built once, on its first lookup, and kept in one
+ * array per kind that follows the layout of the sealed tables. The attribute entries of a cluster are followed by the
+ * global attributes which are not in the data model, so that a lookup is a single span.
+ *
+ * The cache is dropped when the sealed tables are rebuilt. It is only used while the node is sealed.
+ *
+ * All the functions must be called with the Matter stack lock held.
+ */
+
+namespace esp_matter {
+namespace metadata_cache {
+
+/** Build the attribute entry of an attribute of the data model */
+chip::app::DataModel::AttributeEntry make_attribute_entry(chip::ClusterId cluster_id, chip::AttributeId attribute_id,
+                                                          uint16_t flags);
+
+/** Build the accepted command entry of a command of the data model */
+chip::app::DataModel::AcceptedCommandEntry make_accepted_command_entry(chip::ClusterId cluster_id,
+                                                                       chip::CommandId command_id);
+
+/** Get the entries of the global attributes which are not in the data model
+ *
+ * AttributeList, AcceptedCommandList and GeneratedCommandList are served by the Interaction Model engine.
+ */
+chip::Span<const chip::app::DataModel::AttributeEntry> get_global_attributes();
+
+/** Get the attribute entries of a sealed cluster, followed by the global attributes
+ *
+ * @param[in] cluster_id Cluster id.
+ * @param[in] view Sealed view of the cluster.
+ * @param[out] entries Attribute entries.
+ *
+ * @return true on success.
+ * @return false if the cache could not be allocated, the caller should build the entries instead.
+ */
+bool get_attributes(chip::ClusterId cluster_id, const sealed_model::cluster_view_t &view,
+                    chip::Span<const chip::app::DataModel::AttributeEntry> *entries);
+
+/** Get the accepted command entries of a sealed cluster
+ *
+ * @param[in] cluster_id Cluster id.
+ * @param[in] view Sealed view of the cluster.
+ * @param[out] entries Accepted command entries.
+ *
+ * @return true on success.
+ * @return false if the cache could not be allocated, the caller should build the entries instead.
+ */
+bool get_accepted_commands(chip::ClusterId cluster_id, const sealed_model::cluster_view_t &view,
+                           chip::Span<const chip::app::DataModel::AcceptedCommandEntry> *entries);
+
+/** Free the cache */
+void reset();
+
+/** Get the bytes used by the cache */
+size_t get_size();
+
+} // namespace metadata_cache
+} // namespace esp_matter
@@ -19,7 +19,11 @@
 #include <esp_matter_attribute_utils.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_nvs.h>
+#include <esp_matter_nvs_snapshot.h>
+#include <esp_matter_nvs_stats.h>
+#include <esp_timer.h>
 
+#include <algorithm>
 #include <lib/support/Base64.h>
 
 #define ESP_MATTER_NVS_PART_NAME CONFIG_ESP_MATTER_NVS_PART_NAME
@@ -45,17 +49,217 @@ static void get_attribute_key(uint16_t endpoint_id, uint32_t cluster_id, uint32_
      attribute_key[14] = 0;
 }
 
+static bool is_buffer_type(esp_matter_val_type_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        type == ESP_MATTER_VAL_TYPE_ARRAY;
+}
+
+// Size of the value bytes written to the NVS
+static size_t get_val_size(const esp_matter_attr_val_t & val)
+{
+    if (is_buffer_type(val.type)) {
+        return val.val.a.b ? val.val.a.s : 0;
+    }
+    switch (val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+        case ESP_MATTER_VAL_TYPE_BOOLEAN:
+        case ESP_MATTER_VAL_TYPE_INT8:
+        case ESP_MATTER_VAL_TYPE_UINT8:
+        case ESP_MATTER_VAL_TYPE_ENUM8:
+        case ESP_MATTER_VAL_TYPE_BITMAP8:
+            return sizeof(uint8_t);
+        case ESP_MATTER_VAL_TYPE_INT16:
+        case ESP_MATTER_VAL_TYPE_UINT16:
+        case ESP_MATTER_VAL_TYPE_ENUM16:
+        case ESP_MATTER_VAL_TYPE_BITMAP16:
+            return sizeof(uint16_t);
+        case ESP_MATTER_VAL_TYPE_INT64:
+        case ESP_MATTER_VAL_TYPE_UINT64:
+            return sizeof(uint64_t);
+        default:
+            return sizeof(uint32_t);
+    }
+}
+
+// Every commit of the attribute values goes through this, for the write telemetry
+static esp_err_t commit(nvs_handle_t handle)
+{
+    nvs_stats::record_commit();
+    return nvs_commit(handle);
+}
+
 static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_key, const esp_matter_attr_val_t & val);
 static esp_err_t nvs_erase_val(const char *nvs_namespace, const char *attribute_key);
 
-static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_key, esp_matter_attr_val_t & val)
-{
+// While a batch is open, the values stored in the esp_matter_kvs namespace share this handle and are committed once
+static nvs_handle_t batch_handle;
+static bool batch_open = false;
+
+typedef struct restore_key {
+    char key[NVS_KEY_NAME_MAX_SIZE];
+} restore_key_t;
+
+typedef struct legacy_namespace {
+    uint16_t endpoint_id;
+    bool present;
+} legacy_namespace_t;
+
+// State of the restore pass, see begin_nvs_restore()
+typedef struct restore_state {
+    bool open;
+    /* The restore statistics are logged once, by the first end_nvs_restore() */
+    bool logged;
+    /* Read-write handle of the esp_matter_kvs namespace, shared by the reads and the writes of the pass */
     nvs_handle_t handle;
-    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READONLY, &handle);
-    if (err != ESP_OK) {
+    /* Sorted keys of the esp_matter_kvs namespace, only used if they could be listed */
+    bool keys_listed;
+    restore_key_t *keys;
+    size_t key_count;
+    size_t key_capacity;
+    /* Endpoints whose namespace of the older releases was looked for */
+    legacy_namespace_t *legacy_namespaces;
+    size_t legacy_namespace_count;
+    uint32_t read_count;
+    uint32_t restored_count;
+    uint32_t written_count;
+    size_t written_bytes;
+    int64_t elapsed_us;
+} restore_state_t;
+
+static restore_state_t restore_state = {};
+
+static bool compare_keys(const restore_key_t &a, const restore_key_t &b)
+{
+    return strcmp(a.key, b.key) < 0;
+}
+
+// Return whether the key is listed, index is where it is or where it would be inserted
+static bool find_restore_key(const char *attribute_key, size_t *index)
+{
+    size_t low = 0, high = restore_state.key_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strcmp(restore_state.keys[mid].key, attribute_key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *index = low;
+    return low < restore_state.key_count && strcmp(restore_state.keys[low].key, attribute_key) == 0;
+}
+
+static void drop_restore_keys()
+{
+    esp_matter_mem_free(restore_state.keys);
+    restore_state.keys = nullptr;
+    restore_state.key_count = 0;
+    restore_state.key_capacity = 0;
+    restore_state.keys_listed = false;
+}
+
+static bool reserve_restore_keys(size_t count)
+{
+    if (count <= restore_state.key_capacity) {
+        return true;
+    }
+    size_t capacity = std::max(count, restore_state.key_capacity * 2);
+    restore_key_t *keys = (restore_key_t *)esp_matter_mem_realloc(restore_state.keys, capacity * sizeof(restore_key_t));
+    if (!keys) {
+        return false;
+    }
+    restore_state.keys = keys;
+    restore_state.key_capacity = capacity;
+    return true;
+}
+
+// Keep the listed keys in step with the writes of the pass
+static void insert_restore_key(const char *attribute_key)
+{
+    size_t index;
+    if (!restore_state.keys_listed || find_restore_key(attribute_key, &index)) {
+        return;
+    }
+    if (!reserve_restore_keys(restore_state.key_count + 1)) {
+        // Without the list, the reads look the keys up in the NVS
+        ESP_LOGW(TAG, "Couldn't grow the restore key list, reading the keys from the NVS");
+        drop_restore_keys();
+        return;
+    }
+    memmove(&restore_state.keys[index + 1], &restore_state.keys[index],
+            (restore_state.key_count - index) * sizeof(restore_key_t));
+    strlcpy(restore_state.keys[index].key, attribute_key, sizeof(restore_state.keys[index].key));
+    restore_state.key_count++;
+}
+
+static void remove_restore_key(const char *attribute_key)
+{
+    size_t index;
+    if (!restore_state.keys_listed || !find_restore_key(attribute_key, &index)) {
+        return;
+    }
+    memmove(&restore_state.keys[index], &restore_state.keys[index + 1],
+            (restore_state.key_count - index - 1) * sizeof(restore_key_t));
+    restore_state.key_count--;
+}
+
+static esp_err_t list_restore_keys()
+{
+    nvs_iterator_t it = nullptr;
+    esp_err_t err = nvs_entry_find(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_TYPE_ANY, &it);
+    while (err == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+        if (!reserve_restore_keys(restore_state.key_count + 1)) {
+            err = ESP_ERR_NO_MEM;
+            break;
+        }
+        strlcpy(restore_state.keys[restore_state.key_count++].key, info.key, sizeof(restore_key_t));
+        err = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+    // The iteration ends with ESP_ERR_NVS_NOT_FOUND, which is also returned for an empty namespace
+    if (err != ESP_ERR_NVS_NOT_FOUND) {
+        drop_restore_keys();
         return err;
     }
+    std::sort(restore_state.keys, restore_state.keys + restore_state.key_count, compare_keys);
+    restore_state.keys_listed = true;
+    return ESP_OK;
+}
 
+// The namespace of the older releases is looked for once per endpoint
+static bool has_legacy_namespace(uint16_t endpoint_id)
+{
+    for (size_t i = 0; i < restore_state.legacy_namespace_count; ++i) {
+        if (restore_state.legacy_namespaces[i].endpoint_id == endpoint_id) {
+            return restore_state.legacy_namespaces[i].present;
+        }
+    }
+    char nvs_namespace[16] = {0};
+    snprintf(nvs_namespace, 16, "endpoint_%" PRIX16 "", endpoint_id);
+    nvs_handle_t handle;
+    bool present = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READONLY, &handle) == ESP_OK;
+    if (present) {
+        nvs_close(handle);
+    }
+    legacy_namespace_t *namespaces = (legacy_namespace_t *)esp_matter_mem_realloc(
+        restore_state.legacy_namespaces, (restore_state.legacy_namespace_count + 1) * sizeof(legacy_namespace_t));
+    if (namespaces) {
+        namespaces[restore_state.legacy_namespace_count++] = {endpoint_id, present};
+        restore_state.legacy_namespaces = namespaces;
+    }
+    return present;
+}
+
+// Read a value with an open handle. legacy_blob is set if the value is a primitive stored by the older releases as a
+// whole esp_matter_attr_val_t blob, which should be written again as a primitive.
+static esp_err_t nvs_read_val(nvs_handle_t handle, const char *attribute_key, esp_matter_attr_val_t & val,
+                              bool *legacy_blob)
+{
+    esp_err_t err;
+    *legacy_blob = false;
     if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
         val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
         val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
@@ -77,8 +281,6 @@ static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_ke
                 err = nvs_get_blob(handle, attribute_key, buffer, &len);
             }
         }
-
-        nvs_close(handle);
         return err;
     }
 
@@ -180,45 +382,71 @@ static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_ke
         default:
         {
             // handle the case where the type is not recognized
-            nvs_close(handle);
             ESP_LOGE(TAG, "Invalid attribute type: %u", val.type);
             return ESP_ERR_INVALID_ARG;
         }
     }
 
-    // Found the value as primitive data type
-    if (err == ESP_OK) {
-        nvs_close(handle);
-        return err;
-    }
-
     if (err == ESP_ERR_NVS_NOT_FOUND) {
-        // Read as blob, if found, write as primitive data type
+        // Read as blob, if found, it is written again as primitive data type
         size_t len = sizeof(esp_matter_attr_val_t);
         err = nvs_get_blob(handle, attribute_key, &val, &len);
-        if (err == ESP_OK) {
-            // found it as a blob, close the handle
-            nvs_close(handle);
+        *legacy_blob = err == ESP_OK;
+    }
+    return err;
+}
 
-            // nvs_store_val always stores primitive value using primitive data type APIs
-            err = nvs_store_val(nvs_namespace, attribute_key, val);
-            if (err != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to store as primitive data type");
-            }
+static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_key, esp_matter_attr_val_t & val)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    bool legacy_blob;
+    err = nvs_read_val(handle, attribute_key, val, &legacy_blob);
+    nvs_close(handle);
+
+    if (legacy_blob) {
+        // nvs_store_val always stores primitive value using primitive data type APIs
+        if (nvs_store_val(nvs_namespace, attribute_key, val) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to store as primitive data type");
         }
     }
+    return err;
+}
 
-    // There is no harm calling this function even on a closed handle
-    nvs_close(handle);
+// Read a value during the restore pass, the keys which are not listed are not looked up in the NVS
+static esp_err_t restore_get_val(const char *attribute_key, esp_matter_attr_val_t & val)
+{
+    size_t index;
+    if (restore_state.keys_listed && !find_restore_key(attribute_key, &index)) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    bool legacy_blob;
+    esp_err_t err = nvs_read_val(restore_state.handle, attribute_key, val, &legacy_blob);
+    if (legacy_blob) {
+        if (nvs_store_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to store as primitive data type");
+        }
+    }
     return err;
 }
 
 static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_key, const esp_matter_attr_val_t & val)
 {
     nvs_handle_t handle;
-    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
-    if (err != ESP_OK) {
-        return err;
+    esp_err_t err = ESP_OK;
+    bool erased = false;
+    bool kvs_namespace = strcmp(nvs_namespace, ESP_MATTER_KVS_NAMESPACE) == 0;
+    bool batched = (batch_open || restore_state.open) && kvs_namespace;
+    if (batched) {
+        handle = batch_open ? batch_handle : restore_state.handle;
+    } else {
+        err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
+        if (err != ESP_OK) {
+            return err;
+        }
     }
 
     if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
@@ -231,8 +459,8 @@ static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_
             err = nvs_set_blob(handle, attribute_key, val.val.a.b, val.val.a.s);
         } else {
             err = nvs_erase_key(handle, attribute_key);
+            erased = true;
         }
-        nvs_commit(handle);
     } else {
         // This switch case handles primitive data types
         // always store values as primitive data type
@@ -332,34 +560,56 @@ static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_
             }
         }
     }
-    nvs_commit(handle);
-    nvs_close(handle);
+    if (err == ESP_OK && !erased) {
+        nvs_stats::record_write(get_val_size(val), is_buffer_type(val.type) ||
+                                (val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) == ESP_MATTER_VAL_TYPE_FLOAT);
+    }
+    if (!batched) {
+        commit(handle);
+        nvs_close(handle);
+    }
+    if (restore_state.open && kvs_namespace) {
+        restore_state.written_count++;
+        if (erased) {
+            remove_restore_key(attribute_key);
+        } else if (err == ESP_OK) {
+            insert_restore_key(attribute_key);
+        }
+    }
     return err;
 }
 
 static esp_err_t nvs_erase_val(const char *nvs_namespace, const char *attribute_key)
 {
+    if (restore_state.open && strcmp(nvs_namespace, ESP_MATTER_KVS_NAMESPACE) == 0) {
+        remove_restore_key(attribute_key);
+        return nvs_erase_key(restore_state.handle, attribute_key);
+    }
     nvs_handle_t handle;
     esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
     if (err != ESP_OK) {
         return err;
     }
     err = nvs_erase_key(handle, attribute_key);
-    nvs_commit(handle);
+    commit(handle);
     nvs_close(handle);
     return err;
 }
 
-esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val)
+// Read a value stored with one NVS entry per attribute, in the esp_matter_kvs namespace or in the namespace of the
+// endpoint used by the older releases
+static esp_err_t get_key_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                             const char *attribute_key, esp_matter_attr_val_t & val)
 {
-    /* Get attribute key */
-    char attribute_key[16] = {0};
-    get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
-
-    ESP_LOGD(TAG, "read attribute from nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ","
-                  " attribute_id-0x%" PRIx32 "", endpoint_id, cluster_id, attribute_id);
-    esp_err_t err = nvs_get_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
-    if (err == ESP_ERR_NVS_NOT_FOUND) {
+    esp_err_t err;
+    bool try_legacy = true;
+    if (restore_state.open) {
+        err = restore_get_val(attribute_key, val);
+        try_legacy = err == ESP_ERR_NVS_NOT_FOUND && has_legacy_namespace(endpoint_id);
+    } else {
+        err = nvs_get_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
+    }
+    if (err == ESP_ERR_NVS_NOT_FOUND && try_legacy) {
         // If we don't find attribute key in the esp_matter_kvs namespace, we will try to get the attribute value
         // with the previous key from the previous namespace.
         char nvs_namespace[16] = {0};
@@ -381,6 +631,119 @@ esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     return err;
 }
 
+#ifdef CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+// Write the dirty snapshots and commit them, then erase the per-key entries of the values migrated to them
+static esp_err_t write_snapshots(nvs_handle_t handle)
+{
+    size_t written_bytes = 0;
+    esp_err_t err = nvs_snapshot::write_dirty(handle, &written_bytes);
+    esp_err_t commit_err = commit(handle);
+    err = err == ESP_OK ? commit_err : err;
+    if (!restore_state.logged) {
+        restore_state.written_bytes += written_bytes;
+    }
+    uint16_t endpoint_id;
+    uint32_t cluster_id, attribute_id;
+    bool erased = false;
+    while (commit_err == ESP_OK && nvs_snapshot::pop_migrated(&endpoint_id, &cluster_id, &attribute_id)) {
+        char attribute_key[16] = {0};
+        get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
+        nvs_erase_key(handle, attribute_key);
+        remove_restore_key(attribute_key);
+        erased = true;
+    }
+    if (erased) {
+        commit(handle);
+    }
+    return err;
+}
+
+// The snapshots share the handle of the batch or of the restore pass, if one is open. Otherwise a handle is opened
+// for the call, and the changed snapshots are written when a read-write handle is closed.
+static esp_err_t open_snapshot_handle(nvs_open_mode_t open_mode, nvs_handle_t *handle, bool *opened)
+{
+    *opened = false;
+    if (batch_open || restore_state.open) {
+        *handle = batch_open ? batch_handle : restore_state.handle;
+        return ESP_OK;
+    }
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, open_mode, handle);
+    *opened = err == ESP_OK;
+    return err;
+}
+
+// Set a value in the snapshot of its endpoint, or remove it if val is NULL
+static esp_err_t snapshot_store_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                    const esp_matter_attr_val_t *val, bool migrated)
+{
+    nvs_handle_t handle;
+    bool opened;
+    esp_err_t err = open_snapshot_handle(NVS_READWRITE, &handle, &opened);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = val ? nvs_snapshot::set_val(handle, endpoint_id, cluster_id, attribute_id, *val, migrated)
+              : nvs_snapshot::erase_val(handle, endpoint_id, cluster_id, attribute_id);
+    if (opened) {
+        esp_err_t write_err = write_snapshots(handle);
+        err = err == ESP_OK ? write_err : err;
+        nvs_close(handle);
+    }
+    if (restore_state.open) {
+        restore_state.written_count++;
+    }
+    return err;
+}
+
+static esp_err_t snapshot_get_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                  esp_matter_attr_val_t & val)
+{
+    nvs_handle_t handle;
+    bool opened;
+    // The namespace does not exist before the first value is stored, the value is then not found
+    esp_err_t err = open_snapshot_handle(NVS_READONLY, &handle, &opened);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = nvs_snapshot::get_val(handle, endpoint_id, cluster_id, attribute_id, val);
+    if (opened) {
+        nvs_close(handle);
+    }
+    return err;
+}
+#endif // CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+
+esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val)
+{
+    /* Get attribute key */
+    char attribute_key[16] = {0};
+    get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
+
+    ESP_LOGD(TAG, "read attribute from nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ","
+                  " attribute_id-0x%" PRIx32 "", endpoint_id, cluster_id, attribute_id);
+    int64_t start_us = esp_timer_get_time();
+#ifdef CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+    esp_err_t err = snapshot_get_val(endpoint_id, cluster_id, attribute_id, val);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        err = get_key_val(endpoint_id, cluster_id, attribute_id, attribute_key, val);
+        if (err == ESP_OK) {
+            // The per-key entry is erased once the snapshot holding the value is committed
+            if (snapshot_store_val(endpoint_id, cluster_id, attribute_id, &val, true) != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to move attribute_val to the snapshot of the endpoint");
+            }
+        }
+    }
+#else
+    esp_err_t err = get_key_val(endpoint_id, cluster_id, attribute_id, attribute_key, val);
+#endif // CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+    if (!restore_state.logged) {
+        restore_state.read_count++;
+        restore_state.restored_count += err == ESP_OK ? 1 : 0;
+        restore_state.elapsed_us += esp_timer_get_time() - start_us;
+    }
+    return err;
+}
+
 esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t & val)
 {
     /* Get attribute key */
@@ -388,7 +751,99 @@ esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
     ESP_LOGD(TAG, "Store attribute in nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
              endpoint_id, cluster_id, attribute_id);
+    nvs_stats::record_store(endpoint_id, cluster_id, attribute_id, get_val_size(val));
+#ifdef CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+    return snapshot_store_val(endpoint_id, cluster_id, attribute_id, &val, false);
+#else
     return nvs_store_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
+#endif // CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+}
+
+esp_err_t begin_nvs_batch()
+{
+    if (batch_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE,
+                                            &batch_handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    batch_open = true;
+    return ESP_OK;
+}
+
+esp_err_t end_nvs_batch()
+{
+    if (!batch_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    batch_open = false;
+#ifdef CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+    esp_err_t err = write_snapshots(batch_handle);
+#else
+    esp_err_t err = commit(batch_handle);
+#endif // CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+    nvs_close(batch_handle);
+    return err;
+}
+
+esp_err_t begin_nvs_restore()
+{
+#ifdef CONFIG_ESP_MATTER_NVS_BATCHED_RESTORE
+    if (restore_state.open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE,
+                                            &restore_state.handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open the nvs namespace for the restore: %s", esp_err_to_name(err));
+        return err;
+    }
+    err = list_restore_keys();
+    if (err != ESP_OK) {
+        // The pass still shares the handle, the keys are looked up in the NVS
+        ESP_LOGW(TAG, "Failed to list the stored attributes: %s", esp_err_to_name(err));
+    }
+    restore_state.open = true;
+    restore_state.elapsed_us += esp_timer_get_time() - start_us;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif // CONFIG_ESP_MATTER_NVS_BATCHED_RESTORE
+}
+
+esp_err_t end_nvs_restore()
+{
+    esp_err_t err = ESP_OK;
+    if (restore_state.open) {
+        restore_state.open = false;
+        int64_t start_us = esp_timer_get_time();
+#ifdef CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+        err = write_snapshots(restore_state.handle);
+#else
+        err = commit(restore_state.handle);
+#endif // CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+        nvs_close(restore_state.handle);
+        drop_restore_keys();
+        esp_matter_mem_free(restore_state.legacy_namespaces);
+        restore_state.legacy_namespaces = nullptr;
+        restore_state.legacy_namespace_count = 0;
+        restore_state.elapsed_us += esp_timer_get_time() - start_us;
+    }
+    if (!restore_state.logged) {
+        restore_state.logged = true;
+        ESP_LOGI(TAG, "Restored %" PRIu32 " of %" PRIu32 " non-volatile attributes in %" PRId64 " us, %" PRIu32
+                 " values written", restore_state.restored_count, restore_state.read_count, restore_state.elapsed_us,
+                 restore_state.written_count);
+        nvs_stats_t nvs_stats;
+        if (nvs_get_stats(ESP_MATTER_NVS_PART_NAME, &nvs_stats) == ESP_OK) {
+            ESP_LOGI(TAG, "%u of %u NVS entries used, %u bytes of snapshots written", (unsigned)nvs_stats.used_entries,
+                     (unsigned)nvs_stats.total_entries, (unsigned)restore_state.written_bytes);
+        }
+    }
+    return err;
 }
 
 esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
@@ -398,7 +853,23 @@ esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
     ESP_LOGD(TAG, "Erase attribute in nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
              endpoint_id, cluster_id, attribute_id);
+#ifdef CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+    // The value may also still be in its per-key entry if it was not migrated yet
+    nvs_erase_val(ESP_MATTER_KVS_NAMESPACE, attribute_key);
+    return snapshot_store_val(endpoint_id, cluster_id, attribute_id, nullptr, false);
+#else
     return nvs_erase_val(ESP_MATTER_KVS_NAMESPACE, attribute_key);
+#endif // CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+}
+
+void reset_nvs_snapshots()
+{
+    nvs_snapshot::reset();
+}
+
+size_t get_nvs_snapshots_size()
+{
+    return nvs_snapshot::get_size();
 }
 
 } // namespace attribute
@@ -55,5 +55,57 @@ esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
  */
 esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
 
+/**
+ * @brief Starts grouping the attribute values stored with store_val_in_nvs() into one NVS commit.
+ *
+ * The values are written to the NVS as usual, but they are only committed by end_nvs_batch().
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if a batch is already open, appropriate error code otherwise
+ */
+esp_err_t begin_nvs_batch();
+
+/**
+ * @brief Commits the attribute values stored since begin_nvs_batch().
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if no batch is open, appropriate error code otherwise
+ */
+esp_err_t end_nvs_batch();
+
+/**
+ * @brief Starts the restore pass of the non-volatile attributes, node::create() calls this.
+ *
+ * The esp_matter_kvs namespace is opened once and its keys are listed with one NVS iteration. Until end_nvs_restore(),
+ * get_val_from_nvs() does not access the NVS for the keys which are not listed, and the values read, stored or erased
+ * in the namespace share the handle of the pass.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if a pass is already open, ESP_ERR_NOT_SUPPORTED if
+ *         CONFIG_ESP_MATTER_NVS_BATCHED_RESTORE is disabled, appropriate error code otherwise
+ */
+esp_err_t begin_nvs_restore();
+
+/**
+ * @brief Ends the restore pass and commits the values written during it, esp_matter::start() calls this.
+ *
+ * The first call also logs the time spent reading the non-volatile attributes so far, with or without a restore pass.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t end_nvs_restore();
+
+/**
+ * @brief Frees the endpoint snapshots kept in RAM, node::destroy() calls this.
+ *
+ * With CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT, the snapshot of an endpoint is kept in RAM from its first access. They
+ * are loaded again from the NVS when they are needed.
+ */
+void reset_nvs_snapshots();
+
+/**
+ * @brief Gets the bytes used by the endpoint snapshots kept in RAM.
+ *
+ * @return the size in bytes, 0 without CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT
+ */
+size_t get_nvs_snapshots_size();
+
 } // namespace attribute
 } // namespace esp_matter
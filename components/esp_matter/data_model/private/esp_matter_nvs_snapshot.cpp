@@ -0,0 +1,496 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_nvs_snapshot.h>
+#include <esp_matter_nvs_stats.h>
+#include <esp_rom_crc.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+
+static const char *TAG = "mtr_nvs_snapshot";
+
+namespace esp_matter {
+namespace nvs_snapshot {
+
+static constexpr uint32_t k_magic = 0x4e53504d; // "MPSN"
+// Increase it when the layout of the header or of the records changes
+static constexpr uint8_t k_version = 1;
+static constexpr uint8_t k_slot_count = 2;
+static constexpr uint8_t k_no_slot = 0xFF;
+
+typedef struct snapshot_header {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t record_count;
+    uint32_t sequence;
+    /* CRC32 of the whole blob, computed with this field set to 0 */
+    uint32_t crc;
+} snapshot_header_t;
+
+// The records are packed one after the other, they are read and written with memcpy()
+typedef struct record_header {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint16_t size;
+    uint8_t type;
+    uint8_t reserved;
+} record_header_t;
+
+typedef struct snapshot {
+    uint16_t endpoint_id;
+    /* Slot holding the current snapshot in the NVS, k_no_slot if none */
+    uint8_t active_slot;
+    bool dirty;
+    uint32_t sequence;
+    uint16_t record_count;
+    /* The space of the blob header followed by the records, the blob is written from this buffer */
+    uint8_t *buffer;
+    size_t size;
+    size_t capacity;
+    struct snapshot *next;
+} snapshot_t;
+
+typedef struct migrated_path {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+} migrated_path_t;
+
+static snapshot_t *snapshot_list = nullptr;
+// Most of the accesses in a row are for the same endpoint
+static snapshot_t *last_snapshot = nullptr;
+static migrated_path_t *migrated_paths = nullptr;
+static size_t migrated_count = 0;
+
+static bool is_buffer_type(uint8_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        type == ESP_MATTER_VAL_TYPE_ARRAY;
+}
+
+static size_t get_primitive_size(uint8_t type)
+{
+    switch (type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        return 1;
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        return 2;
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+        return 4;
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+static void get_slot_key(uint16_t endpoint_id, uint8_t slot, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "snap_%04" PRIX16 "_%c", endpoint_id, 'a' + slot);
+}
+
+static uint32_t get_crc(const uint8_t *buffer, size_t size)
+{
+    snapshot_header_t header;
+    memcpy(&header, buffer, sizeof(header));
+    header.crc = 0;
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&header, sizeof(header));
+    return esp_rom_crc32_le(crc, buffer + sizeof(header), size - sizeof(header));
+}
+
+// Check the header, the CRC and the bounds of every record
+static bool is_valid(const uint8_t *buffer, size_t size)
+{
+    VerifyOrReturnValue(size >= sizeof(snapshot_header_t), false);
+    snapshot_header_t header;
+    memcpy(&header, buffer, sizeof(header));
+    VerifyOrReturnValue(header.magic == k_magic && header.version == k_version, false);
+    VerifyOrReturnValue(header.crc == get_crc(buffer, size), false);
+    size_t offset = sizeof(header);
+    for (uint16_t i = 0; i < header.record_count; ++i) {
+        record_header_t record;
+        VerifyOrReturnValue(offset + sizeof(record) <= size, false);
+        memcpy(&record, buffer + offset, sizeof(record));
+        offset += sizeof(record) + record.size;
+    }
+    return offset == size;
+}
+
+static bool reserve(snapshot_t *snapshot, size_t size)
+{
+    VerifyOrReturnValue(size > snapshot->capacity, true);
+    size_t capacity = std::max(size, snapshot->capacity + snapshot->capacity / 2);
+    uint8_t *buffer = (uint8_t *)esp_matter_mem_realloc(snapshot->buffer, capacity);
+    VerifyOrReturnValue(buffer, false);
+    snapshot->buffer = buffer;
+    snapshot->capacity = capacity;
+    return true;
+}
+
+// Read a slot, buffer is only set if the slot holds a valid snapshot
+static esp_err_t read_slot(nvs_handle_t handle, uint16_t endpoint_id, uint8_t slot, uint8_t **buffer, size_t *size)
+{
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    get_slot_key(endpoint_id, slot, key, sizeof(key));
+    size_t length = 0;
+    esp_err_t err = nvs_get_blob(handle, key, NULL, &length);
+    VerifyOrReturnError(err == ESP_OK, err);
+    uint8_t *data = (uint8_t *)esp_matter_mem_calloc(1, length);
+    VerifyOrReturnError(data, ESP_ERR_NO_MEM);
+    err = nvs_get_blob(handle, key, data, &length);
+    if (err == ESP_OK && !is_valid(data, length)) {
+        ESP_LOGW(TAG, "Ignoring the corrupted snapshot %s", key);
+        err = ESP_ERR_INVALID_CRC;
+    }
+    if (err != ESP_OK) {
+        esp_matter_mem_free(data);
+        return err;
+    }
+    *buffer = data;
+    *size = length;
+    return ESP_OK;
+}
+
+static esp_err_t load(nvs_handle_t handle, snapshot_t *snapshot)
+{
+    uint8_t *buffers[k_slot_count] = {};
+    size_t sizes[k_slot_count] = {};
+    uint8_t newest = k_no_slot;
+    uint32_t newest_sequence = 0;
+    for (uint8_t slot = 0; slot < k_slot_count; ++slot) {
+        esp_err_t err = read_slot(handle, snapshot->endpoint_id, slot, &buffers[slot], &sizes[slot]);
+        if (err == ESP_ERR_NO_MEM) {
+            esp_matter_mem_free(buffers[0]);
+            return err;
+        }
+        if (err != ESP_OK) {
+            continue;
+        }
+        snapshot_header_t header;
+        memcpy(&header, buffers[slot], sizeof(header));
+        // The sequence numbers wrap around
+        if (newest == k_no_slot || (int32_t)(header.sequence - newest_sequence) > 0) {
+            newest = slot;
+            newest_sequence = header.sequence;
+        }
+    }
+    if (newest == k_no_slot) {
+        return ESP_OK;
+    }
+    for (uint8_t slot = 0; slot < k_slot_count; ++slot) {
+        if (slot != newest) {
+            esp_matter_mem_free(buffers[slot]);
+        }
+    }
+    snapshot_header_t header;
+    memcpy(&header, buffers[newest], sizeof(header));
+    snapshot->buffer = buffers[newest];
+    snapshot->size = sizes[newest];
+    snapshot->capacity = sizes[newest];
+    snapshot->record_count = header.record_count;
+    snapshot->sequence = header.sequence;
+    snapshot->active_slot = newest;
+    return ESP_OK;
+}
+
+static snapshot_t *get_snapshot(nvs_handle_t handle, uint16_t endpoint_id)
+{
+    if (last_snapshot && last_snapshot->endpoint_id == endpoint_id) {
+        return last_snapshot;
+    }
+    for (snapshot_t *snapshot = snapshot_list; snapshot; snapshot = snapshot->next) {
+        if (snapshot->endpoint_id == endpoint_id) {
+            last_snapshot = snapshot;
+            return snapshot;
+        }
+    }
+    snapshot_t *snapshot = (snapshot_t *)esp_matter_mem_calloc(1, sizeof(snapshot_t));
+    VerifyOrReturnValue(snapshot, nullptr, ESP_LOGE(TAG, "Couldn't allocate the snapshot"));
+    snapshot->endpoint_id = endpoint_id;
+    snapshot->active_slot = k_no_slot;
+    esp_err_t err = load(handle, snapshot);
+    if (err == ESP_OK && !snapshot->buffer) {
+        // Nothing is stored for the endpoint yet
+        snapshot->size = sizeof(snapshot_header_t);
+        err = reserve(snapshot, snapshot->size) ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Couldn't load the snapshot of endpoint 0x%" PRIx16 ": %s", endpoint_id, esp_err_to_name(err));
+        esp_matter_mem_free(snapshot->buffer);
+        esp_matter_mem_free(snapshot);
+        return nullptr;
+    }
+    snapshot->next = snapshot_list;
+    snapshot_list = snapshot;
+    last_snapshot = snapshot;
+    return snapshot;
+}
+
+static bool find_record(const snapshot_t *snapshot, uint32_t cluster_id, uint32_t attribute_id, size_t *offset,
+                        record_header_t *record)
+{
+    size_t current = sizeof(snapshot_header_t);
+    for (uint16_t i = 0; i < snapshot->record_count; ++i) {
+        memcpy(record, snapshot->buffer + current, sizeof(*record));
+        if (record->cluster_id == cluster_id && record->attribute_id == attribute_id) {
+            *offset = current;
+            return true;
+        }
+        current += sizeof(*record) + record->size;
+    }
+    return false;
+}
+
+static void remove_record(snapshot_t *snapshot, size_t offset, const record_header_t &record)
+{
+    size_t length = sizeof(record) + record.size;
+    memmove(snapshot->buffer + offset, snapshot->buffer + offset + length, snapshot->size - offset - length);
+    snapshot->size -= length;
+    snapshot->record_count--;
+    snapshot->dirty = true;
+}
+
+esp_err_t get_val(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                  esp_matter_attr_val_t &val)
+{
+    snapshot_t *snapshot = get_snapshot(handle, endpoint_id);
+    VerifyOrReturnError(snapshot, ESP_ERR_NO_MEM);
+    size_t offset;
+    record_header_t record;
+    VerifyOrReturnError(find_record(snapshot, cluster_id, attribute_id, &offset, &record), ESP_ERR_NVS_NOT_FOUND);
+    VerifyOrReturnError(record.type == val.type, ESP_ERR_NVS_TYPE_MISMATCH);
+    const uint8_t *data = snapshot->buffer + offset + sizeof(record);
+
+    if (is_buffer_type(val.type)) {
+        // Like the per-key storage, the size of the attribute value is not decreased
+        size_t len = std::max(static_cast<size_t>(record.size), static_cast<size_t>(val.val.a.s));
+        bool null_reserve = (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING) ||
+            (val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING);
+        uint8_t *buffer = (uint8_t *)esp_matter_mem_calloc(1, len + (null_reserve ? 1 : 0));
+        VerifyOrReturnError(buffer, ESP_ERR_NO_MEM);
+        memcpy(buffer, data, record.size);
+        val.val.a.b = buffer;
+        val.val.a.t = len + (val.val.a.t - val.val.a.s);
+        val.val.a.s = len;
+        return ESP_OK;
+    }
+    VerifyOrReturnError(record.size == get_primitive_size(val.type), ESP_ERR_NVS_INVALID_LENGTH);
+    if ((val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) == ESP_MATTER_VAL_TYPE_BOOLEAN) {
+        val.val.b = data[0] != 0;
+    } else {
+        // All the primitive members of the value union start at its first byte
+        memcpy(&val.val, data, record.size);
+    }
+    return ESP_OK;
+}
+
+esp_err_t set_val(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                  const esp_matter_attr_val_t &val, bool migrated)
+{
+    const uint8_t *data;
+    size_t size;
+    uint8_t b_val;
+    if (is_buffer_type(val.type)) {
+        if (!val.val.a.b) {
+            return erase_val(handle, endpoint_id, cluster_id, attribute_id);
+        }
+        data = val.val.a.b;
+        size = val.val.a.s;
+    } else {
+        size = get_primitive_size(val.type);
+        VerifyOrReturnError(size > 0, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Invalid attribute type: %u", val.type));
+        if ((val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) == ESP_MATTER_VAL_TYPE_BOOLEAN) {
+            b_val = val.val.b != 0;
+            data = &b_val;
+        } else {
+            data = (const uint8_t *)&val.val;
+        }
+    }
+
+    snapshot_t *snapshot = get_snapshot(handle, endpoint_id);
+    VerifyOrReturnError(snapshot, ESP_ERR_NO_MEM);
+    if (migrated) {
+        migrated_path_t *paths = (migrated_path_t *)esp_matter_mem_realloc(
+            migrated_paths, (migrated_count + 1) * sizeof(migrated_path_t));
+        VerifyOrReturnError(paths, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Couldn't allocate the migrated path"));
+        migrated_paths = paths;
+        migrated_paths[migrated_count++] = {endpoint_id, cluster_id, attribute_id};
+    }
+    size_t offset;
+    record_header_t record;
+    if (find_record(snapshot, cluster_id, attribute_id, &offset, &record)) {
+        uint8_t *current = snapshot->buffer + offset + sizeof(record);
+        if (record.type == val.type && record.size == size) {
+            // Most of the changes keep the size, the record is updated in place and nothing is written if the value
+            // did not change
+            if (memcmp(current, data, size) != 0) {
+                memcpy(current, data, size);
+                snapshot->dirty = true;
+            }
+            return ESP_OK;
+        }
+        remove_record(snapshot, offset, record);
+    }
+    VerifyOrReturnError(size <= UINT16_MAX && snapshot->record_count < UINT16_MAX, ESP_ERR_INVALID_SIZE);
+    VerifyOrReturnError(reserve(snapshot, snapshot->size + sizeof(record) + size), ESP_ERR_NO_MEM,
+                        ESP_LOGE(TAG, "Couldn't grow the snapshot of endpoint 0x%" PRIx16, endpoint_id));
+    record = {cluster_id, attribute_id, static_cast<uint16_t>(size), static_cast<uint8_t>(val.type), 0};
+    memcpy(snapshot->buffer + snapshot->size, &record, sizeof(record));
+    memcpy(snapshot->buffer + snapshot->size + sizeof(record), data, size);
+    snapshot->size += sizeof(record) + size;
+    snapshot->record_count++;
+    snapshot->dirty = true;
+    return ESP_OK;
+}
+
+esp_err_t erase_val(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    snapshot_t *snapshot = get_snapshot(handle, endpoint_id);
+    VerifyOrReturnError(snapshot, ESP_ERR_NO_MEM);
+    size_t offset;
+    record_header_t record;
+    if (find_record(snapshot, cluster_id, attribute_id, &offset, &record)) {
+        remove_record(snapshot, offset, record);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t erase_slots(nvs_handle_t handle, snapshot_t *snapshot)
+{
+    for (uint8_t slot = 0; slot < k_slot_count; ++slot) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        get_slot_key(snapshot->endpoint_id, slot, key, sizeof(key));
+        esp_err_t err = nvs_erase_key(handle, key);
+        VerifyOrReturnError(err == ESP_OK || err == ESP_ERR_NVS_NOT_FOUND, err);
+    }
+    snapshot->active_slot = k_no_slot;
+    return ESP_OK;
+}
+
+static esp_err_t write(nvs_handle_t handle, snapshot_t *snapshot)
+{
+    if (snapshot->record_count == 0) {
+        return erase_slots(handle, snapshot);
+    }
+    // The current snapshot is kept until the new one is written
+    uint8_t slot = snapshot->active_slot == 0 ? 1 : 0;
+    snapshot_header_t header = {k_magic, k_version, 0, snapshot->record_count, snapshot->sequence + 1, 0};
+    memcpy(snapshot->buffer, &header, sizeof(header));
+    header.crc = get_crc(snapshot->buffer, snapshot->size);
+    memcpy(snapshot->buffer, &header, sizeof(header));
+
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    get_slot_key(snapshot->endpoint_id, slot, key, sizeof(key));
+    esp_err_t err = nvs_set_blob(handle, key, snapshot->buffer, snapshot->size);
+    VerifyOrReturnError(err == ESP_OK, err);
+    nvs_stats::record_write(snapshot->size, true);
+    snapshot->sequence = header.sequence;
+    snapshot->active_slot = slot;
+    ESP_LOGD(TAG, "Wrote %u bytes for %u attributes of endpoint 0x%" PRIx16 " to %s", (unsigned)snapshot->size,
+             snapshot->record_count, snapshot->endpoint_id, key);
+    return ESP_OK;
+}
+
+esp_err_t write_dirty(nvs_handle_t handle, size_t *written_bytes)
+{
+    esp_err_t err = ESP_OK;
+    size_t bytes = 0;
+    for (snapshot_t *snapshot = snapshot_list; snapshot; snapshot = snapshot->next) {
+        if (!snapshot->dirty) {
+            continue;
+        }
+        esp_err_t write_err = write(handle, snapshot);
+        if (write_err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to write the snapshot of endpoint 0x%" PRIx16 ": %s", snapshot->endpoint_id,
+                     esp_err_to_name(write_err));
+            err = write_err;
+            continue;
+        }
+        snapshot->dirty = false;
+        bytes += snapshot->record_count > 0 ? snapshot->size : 0;
+    }
+    if (written_bytes) {
+        *written_bytes = bytes;
+    }
+    return err;
+}
+
+bool pop_migrated(uint16_t *endpoint_id, uint32_t *cluster_id, uint32_t *attribute_id)
+{
+    for (size_t i = 0; i < migrated_count; ++i) {
+        const migrated_path_t &path = migrated_paths[i];
+        snapshot_t *snapshot = snapshot_list;
+        for (; snapshot && snapshot->endpoint_id != path.endpoint_id; snapshot = snapshot->next) {
+        }
+        if (snapshot && snapshot->dirty) {
+            continue;
+        }
+        *endpoint_id = path.endpoint_id;
+        *cluster_id = path.cluster_id;
+        *attribute_id = path.attribute_id;
+        migrated_paths[i] = migrated_paths[--migrated_count];
+        if (migrated_count == 0) {
+            esp_matter_mem_free(migrated_paths);
+            migrated_paths = nullptr;
+        }
+        return true;
+    }
+    return false;
+}
+
+void reset()
+{
+    while (snapshot_list) {
+        snapshot_t *snapshot = snapshot_list;
+        snapshot_list = snapshot->next;
+        esp_matter_mem_free(snapshot->buffer);
+        esp_matter_mem_free(snapshot);
+    }
+    last_snapshot = nullptr;
+    esp_matter_mem_free(migrated_paths);
+    migrated_paths = nullptr;
+    migrated_count = 0;
+}
+
+size_t get_size()
+{
+    size_t size = migrated_count * sizeof(migrated_path_t);
+    for (snapshot_t *snapshot = snapshot_list; snapshot; snapshot = snapshot->next) {
+        size += sizeof(snapshot_t) + snapshot->capacity;
+    }
+    return size;
+}
+
+} // namespace nvs_snapshot
+} // namespace esp_matter
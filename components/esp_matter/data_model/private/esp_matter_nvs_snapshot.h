@@ -0,0 +1,120 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <nvs.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Packed per-endpoint snapshots of the non-volatile attributes
+ *
+ * With CONFIG_ESP_MATTER_NVS_ENDPOINT_SNAPSHOT, all the non-volatile values of an endpoint are stored in one blob of
+ * the esp_matter_kvs namespace instead of one NVS entry per attribute. The blob starts with a header holding a magic
+ * number, the format version, the record count, a sequence number and the CRC32 of the whole blob, followed by one
+ * record per attribute: the cluster id, the attribute id, the value type, the value size and the value bytes.
+ *
+ * Each endpoint has two slots, snap_<endpoint>_a and snap_<endpoint>_b. A snapshot is always written to the slot
+ * which does not hold the current one, and the loading keeps the valid slot with the highest sequence number, so a
+ * write interrupted by a power loss leaves the previous snapshot in place.
+ *
+ * The snapshot of an endpoint is loaded in RAM on its first access and kept there. The changes only mark it as dirty,
+ * write_dirty() writes the dirty snapshots. The caller owns the NVS handles and the commits.
+ *
+ * All the functions must be called with the Matter stack lock held.
+ */
+
+namespace esp_matter {
+namespace nvs_snapshot {
+
+/** Get a value from the snapshot of its endpoint
+ *
+ * @param[in] handle Handle of the esp_matter_kvs namespace, used to load the snapshot.
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[in] attribute_id Attribute id.
+ * @param[inout] val Value, its type selects how the record is decoded. The strings and the arrays get a new buffer.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NVS_NOT_FOUND if the snapshot has no record for the attribute.
+ * @return error in case of failure.
+ */
+esp_err_t get_val(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                  esp_matter_attr_val_t &val);
+
+/** Set a value in the snapshot of its endpoint
+ *
+ * The snapshot is only marked as dirty if the value changes. A string or an array without a buffer removes the
+ * record, like the per-key storage erases the key.
+ *
+ * @param[in] handle Handle of the esp_matter_kvs namespace, used to load the snapshot.
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[in] attribute_id Attribute id.
+ * @param[in] val Value.
+ * @param[in] migrated Whether the value was read from the per-key storage, its key is then returned by
+ *                     pop_migrated() once the snapshot is written.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_val(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                  const esp_matter_attr_val_t &val, bool migrated);
+
+/** Remove a value from the snapshot of its endpoint
+ *
+ * @param[in] handle Handle of the esp_matter_kvs namespace, used to load the snapshot.
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[in] attribute_id Attribute id.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t erase_val(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/** Write the dirty snapshots to their inactive slot, the caller commits the handle
+ *
+ * The slots of a snapshot without records are erased.
+ *
+ * @param[in] handle Read-write handle of the esp_matter_kvs namespace.
+ * @param[out] written_bytes Bytes written, may be NULL.
+ *
+ * @return ESP_OK on success.
+ * @return error if a snapshot could not be written, it stays dirty.
+ */
+esp_err_t write_dirty(nvs_handle_t handle, size_t *written_bytes);
+
+/** Get the path of a value migrated from the per-key storage whose snapshot is written
+ *
+ * The caller erases the per-key entry once the snapshot is committed, the path is forgotten.
+ *
+ * @param[out] endpoint_id Endpoint id.
+ * @param[out] cluster_id Cluster id.
+ * @param[out] attribute_id Attribute id.
+ *
+ * @return true if a path was returned.
+ */
+bool pop_migrated(uint16_t *endpoint_id, uint32_t *cluster_id, uint32_t *attribute_id);
+
+/** Free the snapshots kept in RAM, the snapshots which are still dirty are lost */
+void reset();
+
+/** Get the bytes used by the snapshots kept in RAM */
+size_t get_size();
+
+} // namespace nvs_snapshot
+} // namespace esp_matter
@@ -0,0 +1,169 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_nvs_stats.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+
+static const char *TAG = "mtr_nvs_stats";
+
+namespace esp_matter {
+namespace nvs_stats {
+
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_STATS
+static constexpr uint16_t k_max_paths = CONFIG_ESP_MATTER_NVS_WRITE_STATS_MAX_PATHS;
+static constexpr uint32_t k_rate_limit = CONFIG_ESP_MATTER_NVS_WRITE_RATE_LIMIT;
+#else
+static constexpr uint16_t k_max_paths = 0;
+static constexpr uint32_t k_rate_limit = 0;
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_STATS
+static constexpr int64_t k_rate_window_ms = 60 * 1000;
+static constexpr size_t k_entry_size = 32;
+static constexpr size_t k_entries_per_page = 126;
+
+typedef struct path_entry {
+    attribute::nvs_path_stats_t stats;
+    int64_t window_start_ms;
+    /* A value of the path was stored since the last commit */
+    bool pending;
+    /* The rate callback was called in the current window */
+    bool reported;
+} path_entry_t;
+
+/* k_max_paths entries, allocated on the first write */
+static path_entry_t *paths = nullptr;
+static uint16_t path_count = 0;
+static attribute::nvs_partition_stats_t totals = {};
+static attribute::nvs_write_rate_callback_t rate_callback = nullptr;
+
+static path_entry_t *get_path(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    for (uint16_t i = 0; i < path_count; ++i) {
+        const attribute::nvs_path_stats_t &stats = paths[i].stats;
+        if (stats.attribute_id == attribute_id && stats.cluster_id == cluster_id && stats.endpoint_id == endpoint_id) {
+            return &paths[i];
+        }
+    }
+    VerifyOrReturnValue(path_count < k_max_paths, nullptr);
+    if (!paths) {
+        paths = (path_entry_t *)esp_matter_mem_calloc(k_max_paths, sizeof(path_entry_t));
+        VerifyOrReturnValue(paths, nullptr, ESP_LOGE(TAG, "Couldn't allocate the NVS write counters"));
+    }
+    path_entry_t *path = &paths[path_count++];
+    memset(path, 0, sizeof(*path));
+    path->stats.endpoint_id = endpoint_id;
+    path->stats.cluster_id = cluster_id;
+    path->stats.attribute_id = attribute_id;
+    return path;
+}
+
+static void check_rate(path_entry_t *path)
+{
+    int64_t now_ms = esp_timer_get_time() / 1000;
+    if (now_ms - path->window_start_ms >= k_rate_window_ms) {
+        path->window_start_ms = now_ms;
+        path->stats.window_write_count = 0;
+        path->reported = false;
+    }
+    path->stats.window_write_count++;
+    VerifyOrReturn(k_rate_limit > 0 && path->stats.window_write_count > k_rate_limit && !path->reported);
+    path->reported = true;
+    if (rate_callback) {
+        rate_callback(&path->stats);
+        return;
+    }
+    ESP_LOGW(TAG, "Attribute 0x%" PRIx32 " of cluster 0x%" PRIx32 " on endpoint 0x%" PRIx16 " was written to the NVS "
+             "more than %" PRIu32 " times in a minute", path->stats.attribute_id, path->stats.cluster_id,
+             path->stats.endpoint_id, k_rate_limit);
+}
+
+void record_store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, size_t size)
+{
+    totals.write_count++;
+    VerifyOrReturn(k_max_paths > 0);
+    path_entry_t *path = get_path(endpoint_id, cluster_id, attribute_id);
+    if (!path) {
+        totals.untracked_write_count++;
+        return;
+    }
+    path->stats.write_count++;
+    path->stats.byte_count += size;
+    path->pending = true;
+    check_rate(path);
+}
+
+void record_write(size_t size, bool blob)
+{
+    totals.byte_count += size;
+    totals.entry_write_count += blob ? 2 + (size + k_entry_size - 1) / k_entry_size : 1;
+}
+
+void record_commit()
+{
+    totals.commit_count++;
+    for (uint16_t i = 0; i < path_count; ++i) {
+        if (paths[i].pending) {
+            paths[i].pending = false;
+            paths[i].stats.commit_count++;
+        }
+    }
+}
+
+void get_stats(attribute::nvs_partition_stats_t *stats)
+{
+    size_t used_entries = stats->used_entries, free_entries = stats->free_entries;
+    size_t total_entries = stats->total_entries;
+    *stats = totals;
+    stats->used_entries = used_entries;
+    stats->free_entries = free_entries;
+    stats->total_entries = total_entries;
+    stats->estimated_page_erases = totals.entry_write_count / k_entries_per_page;
+    size_t page_count = stats->total_entries / k_entries_per_page;
+    stats->estimated_erase_cycles = page_count > 0 ? stats->estimated_page_erases / page_count : 0;
+}
+
+esp_err_t for_each_path(attribute::nvs_path_stats_callback_t callback, void *priv_data)
+{
+    VerifyOrReturnError(k_max_paths > 0, ESP_ERR_NOT_SUPPORTED);
+    for (uint16_t i = 0; i < path_count; ++i) {
+        callback(&paths[i].stats, priv_data);
+    }
+    return ESP_OK;
+}
+
+void set_write_rate_callback(attribute::nvs_write_rate_callback_t callback)
+{
+    rate_callback = callback;
+}
+
+void reset()
+{
+    totals = {};
+    path_count = 0;
+    esp_matter_mem_free(paths);
+    paths = nullptr;
+}
+
+size_t get_size()
+{
+    return paths ? k_max_paths * sizeof(path_entry_t) : 0;
+}
+
+} // namespace nvs_stats
+} // namespace esp_matter
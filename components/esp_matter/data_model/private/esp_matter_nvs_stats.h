@@ -0,0 +1,80 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_data_model.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** NVS write telemetry of the non-volatile attributes
+ *
+ * The NVS module reports every value handed to the NVS, every NVS write and every commit. The totals are always
+ * counted. With CONFIG_ESP_MATTER_NVS_WRITE_STATS, the counters of the first CONFIG_ESP_MATTER_NVS_WRITE_STATS_MAX_PATHS
+ * attribute paths are also kept, and the paths written more than CONFIG_ESP_MATTER_NVS_WRITE_RATE_LIMIT times in a
+ * minute are reported once per minute.
+ *
+ * The flash wear is estimated from the NVS entries consumed by the writes: a primitive value uses one 32-byte entry and
+ * a blob uses two entries plus one per 32 bytes of data. A page holds 126 entries and is erased once they are all
+ * consumed.
+ *
+ * All the functions must be called with the Matter stack lock held.
+ */
+
+namespace esp_matter {
+namespace nvs_stats {
+
+/** Count a value handed to the NVS
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[in] attribute_id Attribute id.
+ * @param[in] size Size of the value in bytes.
+ */
+void record_store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, size_t size);
+
+/** Count an NVS write
+ *
+ * @param[in] size Bytes written.
+ * @param[in] blob Whether the value is written as a blob.
+ */
+void record_write(size_t size, bool blob);
+
+/** Count an NVS commit, the values stored since the previous commit are committed */
+void record_commit();
+
+/** Get the counters
+ *
+ * @param[out] stats Statistics, the NVS entries are filled by the caller.
+ */
+void get_stats(attribute::nvs_partition_stats_t *stats);
+
+/** Call a callback with the counters of every path
+ *
+ * @return ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_MATTER_NVS_WRITE_STATS is disabled.
+ */
+esp_err_t for_each_path(attribute::nvs_path_stats_callback_t callback, void *priv_data);
+
+/** Set the callback for the paths which are written too often */
+void set_write_rate_callback(attribute::nvs_write_rate_callback_t callback);
+
+/** Clear the counters */
+void reset();
+
+/** Get the bytes used by the per-path counters */
+size_t get_size();
+
+} // namespace nvs_stats
+} // namespace esp_matter
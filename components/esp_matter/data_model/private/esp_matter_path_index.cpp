@@ -0,0 +1,234 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_path_index.h>
+#include <string.h>
+
+namespace esp_matter {
+namespace path_index {
+
+#ifdef CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
+
+static const char *TAG = "path_index";
+
+// The entry is 16 bytes on 32-bit targets. An entry with a NULL element is an empty slot.
+typedef struct entry {
+    uint32_t cluster_id;
+    uint32_t element_id;
+    uint16_t endpoint_id;
+    uint8_t kind;
+    void *element;
+} entry_t;
+
+// Open addressing with linear probing, capacity is always a power of two
+static entry_t *s_entries = nullptr;
+static size_t s_capacity = 0;
+static size_t s_count = 0;
+static bool s_incomplete = false;
+
+static constexpr size_t k_min_capacity = 64;
+// The elements of the endpoint templates have no endpoint id and are not indexed
+static constexpr uint16_t k_template_endpoint_id = UINT16_MAX;
+
+static inline uint32_t hash(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+    // murmur3 finalizer over the mixed path ids
+    uint32_t h = cluster_id * 0x9E3779B1;
+    h ^= element_id * 0x85EBCA77;
+    h ^= ((uint32_t)endpoint_id << 8 | kind) * 0xC2B2AE3D;
+    h ^= h >> 16;
+    h *= 0x85EBCA6B;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline bool matches(const entry_t &entry, element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id,
+                           uint32_t element_id)
+{
+    return entry.kind == kind && entry.endpoint_id == endpoint_id && entry.cluster_id == cluster_id &&
+        entry.element_id == element_id;
+}
+
+static void place(entry_t *entries, size_t capacity, const entry_t &entry)
+{
+    size_t mask = capacity - 1;
+    size_t slot = hash((element_kind_t)entry.kind, entry.endpoint_id, entry.cluster_id, entry.element_id) & mask;
+    while (entries[slot].element) {
+        slot = (slot + 1) & mask;
+    }
+    entries[slot] = entry;
+}
+
+static esp_err_t grow()
+{
+    size_t new_capacity = s_capacity ? s_capacity * 2 : k_min_capacity;
+    entry_t *new_entries = (entry_t *)esp_matter_mem_calloc(new_capacity, sizeof(entry_t));
+    if (!new_entries) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < s_capacity; ++i) {
+        if (s_entries[i].element) {
+            place(new_entries, new_capacity, s_entries[i]);
+        }
+    }
+    esp_matter_mem_free(s_entries);
+    s_entries = new_entries;
+    s_capacity = new_capacity;
+    return ESP_OK;
+}
+
+esp_err_t insert(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void *element)
+{
+    if (!element) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (endpoint_id == k_template_endpoint_id) {
+        return ESP_OK;
+    }
+    if (s_incomplete) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // Keep the load factor under 3/4 so that the probe sequences stay short
+    if ((s_count + 1) * 4 > s_capacity * 3) {
+        if (grow() != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to grow the path index, falling back to list lookups");
+            s_incomplete = true;
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    size_t mask = s_capacity - 1;
+    size_t slot = hash(kind, endpoint_id, cluster_id, element_id) & mask;
+    while (s_entries[slot].element) {
+        if (matches(s_entries[slot], kind, endpoint_id, cluster_id, element_id)) {
+            s_entries[slot].element = element;
+            return ESP_OK;
+        }
+        slot = (slot + 1) & mask;
+    }
+    s_entries[slot] = {cluster_id, element_id, endpoint_id, kind, element};
+    s_count++;
+    return ESP_OK;
+}
+
+void remove(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+    if (s_count == 0 || endpoint_id == k_template_endpoint_id) {
+        return;
+    }
+    size_t mask = s_capacity - 1;
+    size_t slot = hash(kind, endpoint_id, cluster_id, element_id) & mask;
+    while (s_entries[slot].element) {
+        if (matches(s_entries[slot], kind, endpoint_id, cluster_id, element_id)) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    if (!s_entries[slot].element) {
+        return;
+    }
+    // Backward shift deletion, so that no tombstones are needed
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+    while (s_entries[next].element) {
+        const entry_t &entry = s_entries[next];
+        size_t home = hash((element_kind_t)entry.kind, entry.endpoint_id, entry.cluster_id, entry.element_id) & mask;
+        // Move the entry into the hole unless its home slot lies cyclically in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            s_entries[hole] = entry;
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    memset(&s_entries[hole], 0, sizeof(entry_t));
+    s_count--;
+}
+
+bool find(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void **element)
+{
+    if (s_incomplete || endpoint_id == k_template_endpoint_id) {
+        return false;
+    }
+    *element = nullptr;
+    if (s_count == 0) {
+        return true;
+    }
+    size_t mask = s_capacity - 1;
+    size_t slot = hash(kind, endpoint_id, cluster_id, element_id) & mask;
+    while (s_entries[slot].element) {
+        if (matches(s_entries[slot], kind, endpoint_id, cluster_id, element_id)) {
+            *element = s_entries[slot].element;
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return true;
+}
+
+void reset()
+{
+    esp_matter_mem_free(s_entries);
+    s_entries = nullptr;
+    s_capacity = 0;
+    s_count = 0;
+    s_incomplete = false;
+}
+
+size_t get_count()
+{
+    return s_count;
+}
+
+size_t get_size()
+{
+    return s_capacity * sizeof(entry_t);
+}
+
+#else
+
+esp_err_t insert(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void *element)
+{
+    return ESP_OK;
+}
+
+void remove(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+}
+
+bool find(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void **element)
+{
+    return false;
+}
+
+void reset()
+{
+}
+
+size_t get_count()
+{
+    return 0;
+}
+
+size_t get_size()
+{
+    return 0;
+}
+
+#endif // CONFIG_ESP_MATTER_DATA_MODEL_PATH_INDEX
+
+} // namespace path_index
+} // namespace esp_matter
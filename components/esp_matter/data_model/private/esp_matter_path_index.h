@@ -0,0 +1,92 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace path_index {
+
+/** Kind of the data model element stored in the path index */
+typedef enum element_kind : uint8_t {
+    ELEMENT_KIND_ENDPOINT = 1,
+    ELEMENT_KIND_CLUSTER,
+    ELEMENT_KIND_ATTRIBUTE,
+    ELEMENT_KIND_COMMAND,
+    ELEMENT_KIND_EVENT,
+} element_kind_t;
+
+/** Add an element to the path index
+ *
+ * The data model calls this whenever an endpoint, cluster, attribute, command or event is created. The unused
+ * ids of the path should be 0, for example the cluster_id and element_id of an endpoint.
+ *
+ * The elements of the endpoint templates, whose endpoint_id is 0xFFFF, are not indexed.
+ *
+ * If the index cannot grow, it is marked as incomplete and `find()` will stop answering until the node is
+ * destroyed, so the callers fall back to walking the lists.
+ *
+ * @param[in] kind Element kind.
+ * @param[in] endpoint_id Endpoint id of the element.
+ * @param[in] cluster_id Cluster id of the element.
+ * @param[in] element_id Attribute, command or event id of the element.
+ * @param[in] element Element handle.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t insert(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id,
+                 void *element);
+
+/** Remove an element from the path index
+ *
+ * Removing a path which is not in the index is not an error.
+ *
+ * @param[in] kind Element kind.
+ * @param[in] endpoint_id Endpoint id of the element.
+ * @param[in] cluster_id Cluster id of the element.
+ * @param[in] element_id Attribute, command or event id of the element.
+ */
+void remove(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id);
+
+/** Find an element in the path index
+ *
+ * @param[in] kind Element kind.
+ * @param[in] endpoint_id Endpoint id of the element.
+ * @param[in] cluster_id Cluster id of the element.
+ * @param[in] element_id Attribute, command or event id of the element.
+ * @param[out] element Element handle, NULL if the path does not exist.
+ *
+ * @return true if the index is complete and `element` is the final answer.
+ * @return false if the caller should search the data model lists instead.
+ */
+bool find(element_kind_t kind, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void **element);
+
+/** Free the path index
+ *
+ * This is called when the node is destroyed.
+ */
+void reset();
+
+/** Get the number of elements in the path index */
+size_t get_count();
+
+/** Get the bytes used by the path index */
+size_t get_size();
+
+} // namespace path_index
+} // namespace esp_matter
@@ -0,0 +1,255 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_data_model_priv.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_report_policy.h>
+#include <esp_timer.h>
+#include <math.h>
+
+#include <app/AttributePathParams.h>
+#include <data_model_provider/esp_matter_data_model_provider.h>
+#include <lib/support/CodeUtils.h>
+#include <platform/CHIPDeviceLayer.h>
+
+static const char *TAG = "esp_matter_report_policy";
+
+namespace esp_matter {
+namespace report_policy {
+
+typedef struct entry {
+    attribute_t *attribute;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    attribute::report_policy_t policy;
+    /* The last reported value, NaN if it was null or if the attribute has not been reported yet */
+    double last_reported;
+    int64_t last_report_time_ms;
+    /* A change was held back by the minimum interval and the timer will report it */
+    bool pending;
+    struct entry *next;
+} entry_t;
+
+static entry_t *entry_list = NULL;
+
+static int64_t get_time_ms()
+{
+    return esp_timer_get_time() / 1000;
+}
+
+static bool get_number(const esp_matter_attr_val_t *val, double *number)
+{
+    if (attribute::val_is_null(const_cast<esp_matter_attr_val_t *>(val))) {
+        return false;
+    }
+    switch (val->type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+        *number = val->val.b ? 1 : 0;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+        *number = val->val.i;
+        return true;
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+        *number = val->val.f;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT8:
+        *number = val->val.i8;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        *number = val->val.u8;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT16:
+        *number = val->val.i16;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        *number = val->val.u16;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        *number = val->val.i32;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+        *number = val->val.u32;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT64:
+        *number = (double)val->val.i64;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        *number = (double)val->val.u64;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static entry_t *get_entry(attribute_t *attribute)
+{
+    for (entry_t *entry = entry_list; entry; entry = entry->next) {
+        if (entry->attribute == attribute) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void set_reported(entry_t *entry, const esp_matter_attr_val_t *val)
+{
+    double number;
+    entry->last_reported = get_number(val, &number) ? number : NAN;
+    entry->last_report_time_ms = get_time_ms();
+    entry->pending = false;
+}
+
+static void report_pending(chip::System::Layer *layer, void *entry_ptr)
+{
+    entry_t *entry = (entry_t *)entry_ptr;
+    VerifyOrReturn(entry->pending);
+    esp_matter_attr_val_t val;
+    VerifyOrReturn(attribute::get_val_internal(entry->attribute, &val) == ESP_OK);
+    set_reported(entry, &val);
+    data_model::provider::get_instance().Temporary_ReportAttributeChanged(
+        chip::app::AttributePathParams(entry->endpoint_id, entry->cluster_id, entry->attribute_id));
+}
+
+static void free_entry(entry_t *entry)
+{
+    if (entry->pending) {
+        chip::DeviceLayer::SystemLayer().CancelTimer(report_pending, entry);
+    }
+    esp_matter_mem_free(entry);
+}
+
+esp_err_t set(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+              const attribute::report_policy_t *policy)
+{
+    VerifyOrReturnError(attribute, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "Attribute cannot be NULL"));
+    if (!policy) {
+        remove(attribute);
+        return ESP_OK;
+    }
+    VerifyOrReturnError(policy->absolute_deadband >= 0 && policy->relative_deadband >= 0, ESP_ERR_INVALID_ARG,
+                        ESP_LOGE(TAG, "The deadbands cannot be negative"));
+    entry_t *entry = get_entry(attribute);
+    if (!entry) {
+        entry = (entry_t *)esp_matter_mem_calloc(1, sizeof(entry_t));
+        VerifyOrReturnError(entry, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Couldn't allocate the report policy"));
+        entry->attribute = attribute;
+        entry->endpoint_id = endpoint_id;
+        entry->cluster_id = cluster_id;
+        entry->attribute_id = attribute_id;
+        entry->last_reported = NAN;
+        entry->next = entry_list;
+        entry_list = entry;
+    }
+    entry->policy = *policy;
+    return ESP_OK;
+}
+
+void remove(attribute_t *attribute)
+{
+    entry_t **link = &entry_list;
+    while (*link) {
+        entry_t *entry = *link;
+        if (entry->attribute == attribute) {
+            *link = entry->next;
+            free_entry(entry);
+            return;
+        }
+        link = &entry->next;
+    }
+}
+
+static bool is_significant_change(const attribute::report_policy_t &policy, double last, double value)
+{
+    double change = fabs(value - last);
+    if (policy.absolute_deadband > 0 && change <= policy.absolute_deadband) {
+        return false;
+    }
+    if (policy.relative_deadband > 0 && change <= fabs(last) * policy.relative_deadband / 100) {
+        return false;
+    }
+    return change > 0;
+}
+
+bool should_report(attribute_t *attribute, const esp_matter_attr_val_t *val)
+{
+    // Only the attributes with a policy look it up, the other updates stay constant time
+    VerifyOrReturnValue(attribute::has_report_policy(attribute), true);
+    entry_t *entry = get_entry(attribute);
+    VerifyOrReturnValue(entry, true);
+    const attribute::report_policy_t &policy = entry->policy;
+
+    double value;
+    bool is_number = get_number(val, &value);
+    if (!is_number || isnan(entry->last_reported)) {
+        // The changes from and to null are always reported
+        set_reported(entry, val);
+        return true;
+    }
+    if (policy.report_on_threshold && ((value >= policy.threshold) != (entry->last_reported >= policy.threshold))) {
+        // Crossing the threshold, in either direction, is reported right away
+        set_reported(entry, val);
+        return true;
+    }
+    if (!is_significant_change(policy, entry->last_reported, value)) {
+        return false;
+    }
+    int64_t elapsed_ms = get_time_ms() - entry->last_report_time_ms;
+    if (policy.min_interval_ms > 0 && elapsed_ms < policy.min_interval_ms) {
+        if (!entry->pending) {
+            entry->pending = true;
+            chip::DeviceLayer::SystemLayer().StartTimer(
+                chip::System::Clock::Milliseconds32(policy.min_interval_ms - elapsed_ms), report_pending, entry);
+        }
+        return false;
+    }
+    set_reported(entry, val);
+    return true;
+}
+
+void mark_reported(attribute_t *attribute, const esp_matter_attr_val_t *val)
+{
+    VerifyOrReturn(attribute::has_report_policy(attribute));
+    entry_t *entry = get_entry(attribute);
+    if (entry) {
+        set_reported(entry, val);
+    }
+}
+
+void reset()
+{
+    while (entry_list) {
+        entry_t *entry = entry_list;
+        entry_list = entry->next;
+        free_entry(entry);
+    }
+}
+
+size_t get_size()
+{
+    size_t size = 0;
+    for (entry_t *entry = entry_list; entry; entry = entry->next) {
+        size += sizeof(entry_t);
+    }
+    return size;
+}
+
+} // namespace report_policy
+} // namespace esp_matter
@@ -0,0 +1,74 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_data_model.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace report_policy {
+
+/** Set or replace the reporting policy of an attribute
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] endpoint_id Endpoint id of the attribute.
+ * @param[in] cluster_id Cluster id of the attribute.
+ * @param[in] attribute_id Attribute id of the attribute.
+ * @param[in] policy Reporting policy, NULL removes the policy.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+              const attribute::report_policy_t *policy);
+
+/** Remove the reporting policy of an attribute which is destroyed
+ *
+ * @param[in] attribute Attribute handle.
+ */
+void remove(attribute_t *attribute);
+
+/** Decide whether a new attribute value should be reported
+ *
+ * This is called after the value was stored. If the change is held back by the minimum interval, a timer reports
+ * the attribute once the interval is over. The caller still changes the data version of the cluster when the change
+ * is not reported now.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] val New value of the attribute.
+ *
+ * @return true if the attribute should be marked as dirty now.
+ */
+bool should_report(attribute_t *attribute, const esp_matter_attr_val_t *val);
+
+/** Record a value which is reported regardless of the policy, such as a value written by a client
+ *
+ * The deadband and the minimum interval of the next changes then start from this value.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] val Reported value of the attribute.
+ */
+void mark_reported(attribute_t *attribute, const esp_matter_attr_val_t *val);
+
+/** Remove all the reporting policies, this is called when the node is destroyed */
+void reset();
+
+/** Get the bytes used by the reporting policies */
+size_t get_size();
+
+} // namespace report_policy
+} // namespace esp_matter
@@ -0,0 +1,344 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_sealed_model.h>
+#include <lib/support/CodeUtils.h>
+#include <string.h>
+
+namespace esp_matter {
+namespace sealed_model {
+
+static const char *TAG = "sealed_model";
+
+// All the arrays live in one allocation. The *_first_* arrays have one more element than their parent array, so
+// that the children of parent i are in [first[i], first[i + 1]).
+typedef struct table {
+    uint32_t generation;
+    size_t endpoint_count;
+    size_t cluster_count;
+    size_t attribute_count;
+    size_t accepted_count;
+    size_t size;
+    cluster_t **clusters;
+    uint32_t *cluster_ids;
+    uint32_t *endpoint_first_cluster;
+    uint32_t *cluster_first_attribute;
+    uint32_t *cluster_first_accepted;
+    uint32_t *cluster_first_generated;
+    uint32_t *attribute_ids;
+    uint32_t *accepted_command_ids;
+    uint32_t *generated_command_ids;
+    uint16_t *endpoint_ids;
+    uint16_t *attribute_flags;
+    uint8_t *cluster_flags;
+} table_t;
+
+static table_t *s_table = nullptr;
+static bool s_sealed = false;
+// Set when building the tables failed, so that the lookups do not retry until the node changes
+static bool s_build_failed = false;
+static uint32_t s_generation = 0;
+
+template <typename T>
+static T *carve(uint8_t *&cursor, size_t count)
+{
+    T *array = reinterpret_cast<T *>(cursor);
+    cursor += count * sizeof(T);
+    return array;
+}
+
+static void sort_ids(uint32_t *ids, uint16_t *flags, size_t count)
+{
+    // The lists are short and mostly created in id order, insertion sort is the cheapest here
+    for (size_t i = 1; i < count; ++i) {
+        uint32_t id = ids[i];
+        uint16_t flag = flags ? flags[i] : 0;
+        size_t j = i;
+        for (; j > 0 && ids[j - 1] > id; --j) {
+            ids[j] = ids[j - 1];
+            if (flags) {
+                flags[j] = flags[j - 1];
+            }
+        }
+        ids[j] = id;
+        if (flags) {
+            flags[j] = flag;
+        }
+    }
+}
+
+static uint32_t get_id(endpoint_t *endpoint)
+{
+    return endpoint::get_id(endpoint);
+}
+
+static uint32_t get_id(cluster_t *cluster)
+{
+    return cluster::get_id(cluster);
+}
+
+template <typename T>
+static void sort_handles(T **handles, size_t count)
+{
+    for (size_t i = 1; i < count; ++i) {
+        T *handle = handles[i];
+        size_t j = i;
+        for (; j > 0 && get_id(handles[j - 1]) > get_id(handle); --j) {
+            handles[j] = handles[j - 1];
+        }
+        handles[j] = handle;
+    }
+}
+
+static esp_err_t build()
+{
+    node_t *node = node::get();
+    VerifyOrReturnError(node, ESP_ERR_INVALID_STATE, ESP_LOGE(TAG, "Node cannot be NULL"));
+
+    size_t endpoint_count = 0, cluster_count = 0, attribute_count = 0, accepted_count = 0, generated_count = 0;
+    for (endpoint_t *ep = endpoint::get_first(node); ep; ep = endpoint::get_next(ep)) {
+        endpoint_count++;
+        for (cluster_t *cl = cluster::get_first(ep); cl; cl = cluster::get_next(cl)) {
+            cluster_count++;
+            for (attribute_t *attr = attribute::get_first(cl); attr; attr = attribute::get_next(attr)) {
+                attribute_count++;
+            }
+            for (command_t *cmd = command::get_first(cl); cmd; cmd = command::get_next(cmd)) {
+                uint16_t flags = command::get_flags(cmd);
+                accepted_count += (flags & COMMAND_FLAG_ACCEPTED) ? 1 : 0;
+                generated_count += (flags & COMMAND_FLAG_GENERATED) ? 1 : 0;
+            }
+        }
+    }
+
+    // Pointers first and the narrower arrays last, so that every array is naturally aligned
+    size_t size = sizeof(table_t) + cluster_count * sizeof(cluster_t *) +
+        (cluster_count + (endpoint_count + 1) + 3 * (cluster_count + 1) + attribute_count + accepted_count +
+         generated_count) * sizeof(uint32_t) +
+        (endpoint_count + attribute_count) * sizeof(uint16_t) + cluster_count * sizeof(uint8_t);
+    uint8_t *buffer = (uint8_t *)esp_matter_mem_calloc(1, size);
+    VerifyOrReturnError(buffer, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Couldn't allocate the sealed tables"));
+    endpoint_t **endpoints = (endpoint_t **)esp_matter_mem_calloc(endpoint_count ? endpoint_count : 1,
+                                                                  sizeof(endpoint_t *));
+    if (!endpoints) {
+        esp_matter_mem_free(buffer);
+        ESP_LOGE(TAG, "Couldn't allocate the endpoint handles");
+        return ESP_ERR_NO_MEM;
+    }
+
+    table_t *table = (table_t *)buffer;
+    uint8_t *cursor = buffer + sizeof(table_t);
+    table->generation = ++s_generation;
+    table->endpoint_count = endpoint_count;
+    table->cluster_count = cluster_count;
+    table->attribute_count = attribute_count;
+    table->accepted_count = accepted_count;
+    table->size = size;
+    table->clusters = carve<cluster_t *>(cursor, cluster_count);
+    table->cluster_ids = carve<uint32_t>(cursor, cluster_count);
+    table->endpoint_first_cluster = carve<uint32_t>(cursor, endpoint_count + 1);
+    table->cluster_first_attribute = carve<uint32_t>(cursor, cluster_count + 1);
+    table->cluster_first_accepted = carve<uint32_t>(cursor, cluster_count + 1);
+    table->cluster_first_generated = carve<uint32_t>(cursor, cluster_count + 1);
+    table->attribute_ids = carve<uint32_t>(cursor, attribute_count);
+    table->accepted_command_ids = carve<uint32_t>(cursor, accepted_count);
+    table->generated_command_ids = carve<uint32_t>(cursor, generated_count);
+    table->endpoint_ids = carve<uint16_t>(cursor, endpoint_count);
+    table->attribute_flags = carve<uint16_t>(cursor, attribute_count);
+    table->cluster_flags = carve<uint8_t>(cursor, cluster_count);
+
+    size_t index = 0;
+    for (endpoint_t *ep = endpoint::get_first(node); ep; ep = endpoint::get_next(ep)) {
+        endpoints[index++] = ep;
+    }
+    sort_handles(endpoints, endpoint_count);
+
+    uint32_t cl_index = 0, attr_index = 0, accepted_index = 0, generated_index = 0;
+    for (size_t ep_index = 0; ep_index < endpoint_count; ++ep_index) {
+        table->endpoint_ids[ep_index] = endpoint::get_id(endpoints[ep_index]);
+        table->endpoint_first_cluster[ep_index] = cl_index;
+        uint32_t first_cluster = cl_index;
+        for (cluster_t *cl = cluster::get_first(endpoints[ep_index]); cl; cl = cluster::get_next(cl)) {
+            table->clusters[cl_index++] = cl;
+        }
+        sort_handles(&table->clusters[first_cluster], cl_index - first_cluster);
+
+        for (uint32_t i = first_cluster; i < cl_index; ++i) {
+            cluster_t *cl = table->clusters[i];
+            table->cluster_ids[i] = cluster::get_id(cl);
+            table->cluster_flags[i] = cluster::get_flags(cl);
+            table->cluster_first_attribute[i] = attr_index;
+            table->cluster_first_accepted[i] = accepted_index;
+            table->cluster_first_generated[i] = generated_index;
+            for (attribute_t *attr = attribute::get_first(cl); attr; attr = attribute::get_next(attr)) {
+                table->attribute_ids[attr_index] = attribute::get_id(attr);
+                table->attribute_flags[attr_index] = attribute::get_flags(attr);
+                attr_index++;
+            }
+            for (command_t *cmd = command::get_first(cl); cmd; cmd = command::get_next(cmd)) {
+                uint16_t flags = command::get_flags(cmd);
+                if (flags & COMMAND_FLAG_ACCEPTED) {
+                    table->accepted_command_ids[accepted_index++] = command::get_id(cmd);
+                }
+                if (flags & COMMAND_FLAG_GENERATED) {
+                    table->generated_command_ids[generated_index++] = command::get_id(cmd);
+                }
+            }
+            uint32_t first = table->cluster_first_attribute[i];
+            sort_ids(&table->attribute_ids[first], &table->attribute_flags[first], attr_index - first);
+            first = table->cluster_first_accepted[i];
+            sort_ids(&table->accepted_command_ids[first], nullptr, accepted_index - first);
+            first = table->cluster_first_generated[i];
+            sort_ids(&table->generated_command_ids[first], nullptr, generated_index - first);
+        }
+    }
+    table->endpoint_first_cluster[endpoint_count] = cl_index;
+    table->cluster_first_attribute[cluster_count] = attr_index;
+    table->cluster_first_accepted[cluster_count] = accepted_index;
+    table->cluster_first_generated[cluster_count] = generated_index;
+    esp_matter_mem_free(endpoints);
+
+    esp_matter_mem_free(s_table);
+    s_table = table;
+    ESP_LOGD(TAG, "Sealed %u endpoints, %u clusters, %u attributes in %u bytes", (unsigned)endpoint_count,
+             (unsigned)cluster_count, (unsigned)attribute_count, (unsigned)size);
+    return ESP_OK;
+}
+
+static const table_t *get_table()
+{
+    if (!s_table && s_sealed && !s_build_failed) {
+        s_build_failed = build() != ESP_OK;
+    }
+    return s_table;
+}
+
+static bool find_endpoint(const table_t *table, uint16_t endpoint_id, size_t *index)
+{
+    size_t low = 0, high = table->endpoint_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (table->endpoint_ids[mid] < endpoint_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    VerifyOrReturnValue(low < table->endpoint_count && table->endpoint_ids[low] == endpoint_id, false);
+    *index = low;
+    return true;
+}
+
+esp_err_t seal()
+{
+    s_sealed = true;
+    s_build_failed = false;
+    esp_err_t err = build();
+    if (err != ESP_OK) {
+        s_sealed = false;
+    }
+    return err;
+}
+
+void unseal()
+{
+    s_sealed = false;
+    s_build_failed = false;
+    esp_matter_mem_free(s_table);
+    s_table = nullptr;
+}
+
+bool is_sealed()
+{
+    return s_sealed;
+}
+
+void invalidate()
+{
+    s_build_failed = false;
+    if (s_table) {
+        esp_matter_mem_free(s_table);
+        s_table = nullptr;
+    }
+}
+
+bool get_endpoint(uint16_t endpoint_id, endpoint_view_t *view)
+{
+    const table_t *table = get_table();
+    VerifyOrReturnValue(table, false);
+    size_t ep_index;
+    VerifyOrReturnValue(find_endpoint(table, endpoint_id, &ep_index), false);
+    uint32_t first = table->endpoint_first_cluster[ep_index];
+    view->cluster_ids = &table->cluster_ids[first];
+    view->cluster_flags = &table->cluster_flags[first];
+    view->clusters = &table->clusters[first];
+    view->count = table->endpoint_first_cluster[ep_index + 1] - first;
+    return true;
+}
+
+bool get_cluster(uint16_t endpoint_id, uint32_t cluster_id, cluster_view_t *view)
+{
+    const table_t *table = get_table();
+    VerifyOrReturnValue(table, false);
+    size_t ep_index;
+    VerifyOrReturnValue(find_endpoint(table, endpoint_id, &ep_index), false);
+    size_t low = table->endpoint_first_cluster[ep_index], high = table->endpoint_first_cluster[ep_index + 1];
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (table->cluster_ids[mid] < cluster_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    VerifyOrReturnValue(low < table->endpoint_first_cluster[ep_index + 1] && table->cluster_ids[low] == cluster_id,
+                        false);
+    uint32_t first;
+    view->cluster = table->clusters[low];
+    view->index = low;
+    view->first_attribute = table->cluster_first_attribute[low];
+    view->first_accepted_command = table->cluster_first_accepted[low];
+    first = table->cluster_first_attribute[low];
+    view->attribute_ids = &table->attribute_ids[first];
+    view->attribute_flags = &table->attribute_flags[first];
+    view->attribute_count = table->cluster_first_attribute[low + 1] - first;
+    first = table->cluster_first_accepted[low];
+    view->accepted_command_ids = &table->accepted_command_ids[first];
+    view->accepted_command_count = table->cluster_first_accepted[low + 1] - first;
+    first = table->cluster_first_generated[low];
+    view->generated_command_ids = &table->generated_command_ids[first];
+    view->generated_command_count = table->cluster_first_generated[low + 1] - first;
+    return true;
+}
+
+bool get_layout(layout_t *layout)
+{
+    const table_t *table = get_table();
+    VerifyOrReturnValue(table, false);
+    layout->generation = table->generation;
+    layout->cluster_count = table->cluster_count;
+    layout->attribute_count = table->attribute_count;
+    layout->accepted_command_count = table->accepted_count;
+    return true;
+}
+
+size_t get_size()
+{
+    return s_table ? s_table->size : 0;
+}
+
+} // namespace sealed_model
+} // namespace esp_matter
@@ -0,0 +1,125 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_data_model.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace sealed_model {
+
+/** Sealed view of the clusters of an endpoint
+ *
+ * The arrays are sorted by cluster id and have `count` elements.
+ */
+typedef struct endpoint_view {
+    const uint32_t *cluster_ids;
+    const uint8_t *cluster_flags;
+    cluster_t *const *clusters;
+    size_t count;
+} endpoint_view_t;
+
+/** Sealed view of the attributes and commands of a cluster
+ *
+ * The arrays are sorted by id. The command arrays only have the commands with the accepted or generated flag
+ * respectively.
+ */
+typedef struct cluster_view {
+    cluster_t *cluster;
+    /* Position of the cluster, of its first attribute and of its first accepted command in the sealed tables */
+    size_t index;
+    size_t first_attribute;
+    size_t first_accepted_command;
+    const uint32_t *attribute_ids;
+    const uint16_t *attribute_flags;
+    size_t attribute_count;
+    const uint32_t *accepted_command_ids;
+    size_t accepted_command_count;
+    const uint32_t *generated_command_ids;
+    size_t generated_command_count;
+} cluster_view_t;
+
+/** Shape of the sealed tables
+ *
+ * The generation changes every time the tables are rebuilt, so that the caches built on top of the views can tell
+ * when they are stale.
+ */
+typedef struct layout {
+    uint32_t generation;
+    size_t cluster_count;
+    size_t attribute_count;
+    size_t accepted_command_count;
+} layout_t;
+
+/** Seal the data model
+ *
+ * Build the sealed tables from the endpoint, cluster, attribute and command lists of the node. The node stays
+ * sealed until `unseal()` is called: if the node changes shape, the tables are dropped and rebuilt on the next
+ * lookup.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t seal();
+
+/** Unseal the data model and free the sealed tables */
+void unseal();
+
+/** Check whether the data model is sealed */
+bool is_sealed();
+
+/** Drop the sealed tables
+ *
+ * The data model calls this whenever an endpoint, cluster, attribute, command or event is created or destroyed.
+ */
+void invalidate();
+
+/** Get the sealed view of an endpoint
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[out] view Sealed view of the endpoint.
+ *
+ * @return true if the node is sealed and the endpoint exists.
+ * @return false if the caller should walk the data model lists instead.
+ */
+bool get_endpoint(uint16_t endpoint_id, endpoint_view_t *view);
+
+/** Get the sealed view of a cluster
+ *
+ * @param[in] endpoint_id Endpoint id.
+ * @param[in] cluster_id Cluster id.
+ * @param[out] view Sealed view of the cluster.
+ *
+ * @return true if the node is sealed and the cluster exists.
+ * @return false if the caller should walk the data model lists instead.
+ */
+bool get_cluster(uint16_t endpoint_id, uint32_t cluster_id, cluster_view_t *view);
+
+/** Get the shape of the sealed tables
+ *
+ * @param[out] layout Shape of the tables.
+ *
+ * @return true if the node is sealed.
+ * @return false otherwise.
+ */
+bool get_layout(layout_t *layout);
+
+/** Get the bytes used by the sealed tables */
+size_t get_size();
+
+} // namespace sealed_model
+} // namespace esp_matter
@@ -0,0 +1,234 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_model_priv.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_nvs.h>
+#include <esp_matter_write_behind.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+
+#include <lib/support/CodeUtils.h>
+#include <platform/CHIPDeviceLayer.h>
+
+static const char *TAG = "esp_matter_write_behind";
+
+namespace esp_matter {
+namespace write_behind {
+
+#ifdef CONFIG_ESP_MATTER_NVS_WRITE_BEHIND
+static constexpr int64_t k_idle_ms = CONFIG_ESP_MATTER_NVS_WRITE_BEHIND_IDLE_MS;
+static constexpr uint16_t k_max_dirty = CONFIG_ESP_MATTER_NVS_WRITE_BEHIND_MAX_DIRTY;
+#else
+static constexpr int64_t k_idle_ms = 0;
+static constexpr uint16_t k_max_dirty = 0;
+#endif // CONFIG_ESP_MATTER_NVS_WRITE_BEHIND
+// A value which keeps changing is still written after this time
+static constexpr int64_t k_max_delay_ms = 4 * k_idle_ms;
+static constexpr int64_t k_deferred_ms = CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS;
+// The restart waits at most this long for the Matter stack lock to write the dirty attributes
+static constexpr uint32_t k_shutdown_lock_wait_ms = 100;
+
+typedef struct entry {
+    attribute_t *attribute;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    /* Time at which the value is written at the latest, set by its first change or by a failed write */
+    int64_t deadline_ms;
+    bool deferred;
+    /* The last write failed, the value is written again at the deadline */
+    bool failed;
+} entry_t;
+
+/* k_max_dirty entries, allocated on the first change */
+static entry_t *entries = nullptr;
+static uint16_t entry_count = 0;
+/* Time of the last change of an attribute without the deferred persistence */
+static int64_t last_change_ms = 0;
+static attribute::persistence_stats_t stats = {};
+
+static int64_t get_time_ms()
+{
+    return esp_timer_get_time() / 1000;
+}
+
+static int64_t get_due_ms(const entry_t &entry)
+{
+    // The attributes without the deferred persistence are written together once no attribute changed for a while
+    return entry.deferred || entry.failed ? entry.deadline_ms : std::min(entry.deadline_ms, last_change_ms + k_idle_ms);
+}
+
+static void flush_due(chip::System::Layer *layer, void *context);
+
+static void schedule()
+{
+    if (entry_count == 0) {
+        chip::DeviceLayer::SystemLayer().CancelTimer(flush_due, nullptr);
+        return;
+    }
+    int64_t due_ms = INT64_MAX;
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        due_ms = std::min(due_ms, get_due_ms(entries[i]));
+    }
+    int64_t delay_ms = std::max<int64_t>(due_ms - get_time_ms(), 0);
+    // Starting the timer again replaces the pending one
+    chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(delay_ms), flush_due, nullptr);
+}
+
+// Write the attributes which are due, or all of them, with one NVS commit
+static esp_err_t write(bool all)
+{
+    VerifyOrReturnError(entry_count > 0, ESP_OK);
+    int64_t now_ms = get_time_ms();
+    bool batch = attribute::begin_nvs_batch() == ESP_OK;
+    esp_err_t err = ESP_OK;
+    uint16_t kept_count = 0;
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        entry_t &entry = entries[i];
+        if (!all && get_due_ms(entry) > now_ms) {
+            entries[kept_count++] = entry;
+            continue;
+        }
+        esp_matter_attr_val_t val;
+        esp_err_t write_err = attribute::get_val_internal(entry.attribute, &val);
+        if (write_err == ESP_OK) {
+            write_err = attribute::store_val_in_nvs(entry.endpoint_id, entry.cluster_id, entry.attribute_id, val);
+        }
+        if (write_err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to store the attribute 0x%" PRIx32 " of cluster 0x%" PRIx32 " on endpoint 0x%" PRIx16
+                     ": %s", entry.attribute_id, entry.cluster_id, entry.endpoint_id, esp_err_to_name(write_err));
+            err = write_err;
+            // Keep the value, the error might be transient such as the NVS being full until its garbage collection
+            entry.deadline_ms = now_ms + k_max_delay_ms;
+            entry.failed = true;
+            entries[kept_count++] = entry;
+            continue;
+        }
+        stats.write_count++;
+    }
+    entry_count = kept_count;
+    if (batch) {
+        esp_err_t commit_err = attribute::end_nvs_batch();
+        err = err == ESP_OK ? commit_err : err;
+    }
+    stats.flush_count++;
+    return err;
+}
+
+static void flush_due(chip::System::Layer *layer, void *context)
+{
+    write(false);
+    schedule();
+}
+
+static void flush_on_shutdown()
+{
+    VerifyOrReturn(entry_count > 0);
+    lock::status_t lock_status = lock::chip_stack_lock(pdMS_TO_TICKS(k_shutdown_lock_wait_ms));
+    VerifyOrReturn(lock_status != lock::FAILED,
+                   ESP_LOGW(TAG, "Couldn't take the Matter stack lock, %u dirty attributes are not stored",
+                            entry_count));
+    write(true);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+}
+
+esp_err_t mark_dirty(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                     bool deferred)
+{
+    VerifyOrReturnError(k_max_dirty > 0, ESP_ERR_NOT_SUPPORTED);
+    // The Matter timers do not run before the start, the values changed while the node is created are written now
+    VerifyOrReturnError(is_started(), ESP_ERR_INVALID_STATE);
+    if (!entries) {
+        entries = (entry_t *)esp_matter_mem_calloc(k_max_dirty, sizeof(entry_t));
+        VerifyOrReturnError(entries, ESP_ERR_NO_MEM, ESP_LOGE(TAG, "Couldn't allocate the dirty attributes"));
+        esp_err_t err = esp_register_shutdown_handler(flush_on_shutdown);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            ESP_LOGW(TAG, "Couldn't register the shutdown handler: %s", esp_err_to_name(err));
+        }
+    }
+    int64_t now_ms = get_time_ms();
+    stats.change_count++;
+    if (!deferred) {
+        last_change_ms = now_ms;
+    }
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        if (entries[i].attribute == attribute) {
+            // The queued write stores the new value
+            stats.avoided_write_count++;
+            schedule();
+            return ESP_OK;
+        }
+    }
+    if (entry_count >= k_max_dirty) {
+        // The set is still full of values which could not be written, try them again before giving up
+        write(true);
+        VerifyOrReturnError(entry_count < k_max_dirty, ESP_ERR_NO_MEM, schedule());
+    }
+    entries[entry_count++] = {attribute, endpoint_id, cluster_id, attribute_id,
+                              now_ms + (deferred ? k_deferred_ms : k_max_delay_ms), deferred, false};
+    if (entry_count >= k_max_dirty) {
+        write(true);
+    }
+    schedule();
+    return ESP_OK;
+}
+
+esp_err_t flush()
+{
+    VerifyOrReturnError(entry_count > 0, ESP_OK);
+    esp_err_t err = write(true);
+    schedule();
+    return err;
+}
+
+void remove(attribute_t *attribute)
+{
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        if (entries[i].attribute == attribute) {
+            entries[i] = entries[--entry_count];
+            schedule();
+            return;
+        }
+    }
+}
+
+void reset()
+{
+    if (entry_count > 0) {
+        entry_count = 0;
+        chip::DeviceLayer::SystemLayer().CancelTimer(flush_due, nullptr);
+    }
+    esp_matter_mem_free(entries);
+    entries = nullptr;
+}
+
+void get_stats(attribute::persistence_stats_t *stats_out)
+{
+    *stats_out = stats;
+    stats_out->dirty_count = entry_count;
+}
+
+size_t get_size()
+{
+    return entries ? k_max_dirty * sizeof(entry_t) : 0;
+}
+
+} // namespace write_behind
+} // namespace esp_matter
@@ -0,0 +1,84 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_data_model.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Write-behind persistence of the non-volatile attributes
+ *
+ * With CONFIG_ESP_MATTER_NVS_WRITE_BEHIND, a change of a non-volatile attribute marks it as dirty instead of writing
+ * it to the NVS. The dirty attributes are written together, with one NVS commit, once no attribute changed for
+ * CONFIG_ESP_MATTER_NVS_WRITE_BEHIND_IDLE_MS, at the latest four times that long after their first change, or as soon
+ * as CONFIG_ESP_MATTER_NVS_WRITE_BEHIND_MAX_DIRTY attributes are dirty. The attributes with the deferred persistence
+ * are written CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS after their first change, with the next flush.
+ *
+ * The current value of the attribute is written, so the changes in between are never written. All the dirty
+ * attributes are written before the restart, which also covers the OTA apply, and before the ICD enters the idle mode.
+ *
+ * All the functions must be called with the Matter stack lock held.
+ */
+
+namespace esp_matter {
+namespace write_behind {
+
+/** Mark a non-volatile attribute as dirty
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] endpoint_id Endpoint id of the attribute.
+ * @param[in] cluster_id Cluster id of the attribute.
+ * @param[in] attribute_id Attribute id of the attribute.
+ * @param[in] deferred Whether the attribute has the deferred persistence.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE before esp_matter::start(), the caller should then write the attribute.
+ * @return error if the attribute could not be marked, the caller should then write it.
+ */
+esp_err_t mark_dirty(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                     bool deferred);
+
+/** Write all the dirty attributes with one NVS commit
+ *
+ * The values which could not be written stay dirty and are written again later.
+ *
+ * @return ESP_OK on success.
+ * @return error if some of the values could not be written.
+ */
+esp_err_t flush();
+
+/** Forget a dirty attribute which is destroyed, its stored value is erased with it
+ *
+ * @param[in] attribute Attribute handle.
+ */
+void remove(attribute_t *attribute);
+
+/** Forget all the dirty attributes without writing them, this is called before the factory reset erases the NVS and
+ * after flush() when the node is destroyed
+ */
+void reset();
+
+/** Get the write-behind statistics
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(attribute::persistence_stats_t *stats);
+
+/** Get the bytes used by the dirty set */
+size_t get_size();
+
+} // namespace write_behind
+} // namespace esp_matter
@@ -4,9 +4,16 @@
 #include "support/CHIPMemString.h"
 #include "support/CodeUtils.h"
 
+#include <protocols/interaction_model/StatusCode.h>
+
 namespace esp_matter {
 namespace data_model {
 
+attribute_data_decode_buffer::~attribute_data_decode_buffer()
+{
+    esp_matter_mem_free(m_allocated);
+}
+
 CHIP_ERROR attribute_data_decode_buffer::Decode(chip::TLV::TLVReader &reader)
 {
     switch (m_attr_val.type) {
@@ -122,10 +129,17 @@ CHIP_ERROR attribute_data_decode_buffer::Decode(chip::TLV::TLVReader &reader)
         if (len > 0xFF && m_attr_val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING) {
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
-        // The allocated buffer will be freed in destructor
-        m_attr_val.val.a.b = (uint8_t *)esp_matter_mem_calloc(len + 1, sizeof(char));
-        if (!m_attr_val.val.a.b) {
-            return CHIP_ERROR_NO_MEMORY;
+        VerifyOrReturnError(len <= m_max_size, CHIP_IM_GLOBAL_STATUS(ResourceExhausted));
+        // The callbacks get a null terminated string, so it cannot stay in the TLV data
+        if (len < sizeof(m_string)) {
+            m_attr_val.val.a.b = (uint8_t *)m_string;
+        } else {
+            // The allocated buffer will be freed in destructor
+            m_allocated = (uint8_t *)esp_matter_mem_calloc(len + 1, sizeof(char));
+            if (!m_allocated) {
+                return CHIP_ERROR_NO_MEMORY;
+            }
+            m_attr_val.val.a.b = m_allocated;
         }
         ReturnErrorOnFailure(reader.GetString((char *)m_attr_val.val.a.b, len + 1));
         m_attr_val.val.a.s = len;
@@ -144,12 +158,20 @@ CHIP_ERROR attribute_data_decode_buffer::Decode(chip::TLV::TLVReader &reader)
         if (len > 0xFF && m_attr_val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING) {
             return CHIP_ERROR_INVALID_ARGUMENT;
         }
-        // The allocated buffer will be freed in destructor
-        m_attr_val.val.a.b = (uint8_t *)esp_matter_mem_calloc(len, sizeof(uint8_t));
-        if (!m_attr_val.val.a.b) {
-            return CHIP_ERROR_NO_MEMORY;
+        VerifyOrReturnError(len <= m_max_size, CHIP_IM_GLOBAL_STATUS(ResourceExhausted));
+        chip::ByteSpan bytes;
+        if (reader.Get(bytes) == CHIP_NO_ERROR) {
+            // The bytes stay in the TLV data, they are only read
+            m_attr_val.val.a.b = const_cast<uint8_t *>(bytes.data());
+        } else {
+            // The TLV data is not contiguous, the allocated buffer will be freed in destructor
+            m_allocated = (uint8_t *)esp_matter_mem_calloc(len, sizeof(uint8_t));
+            if (!m_allocated) {
+                return CHIP_ERROR_NO_MEMORY;
+            }
+            m_attr_val.val.a.b = m_allocated;
+            ReturnErrorOnFailure(reader.GetBytes(m_attr_val.val.a.b, len));
         }
-        ReturnErrorOnFailure(reader.GetBytes(m_attr_val.val.a.b, len));
         m_attr_val.val.a.s = len;
         m_attr_val.val.a.t = len + (m_attr_val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ? 1 : 2);
         break;
@@ -32,24 +32,43 @@ public:
         memset(&m_attr_val.val, 0, sizeof(m_attr_val.val));
     }
 
-    ~attribute_data_decode_buffer()
+    /** Decode a new value of an attribute
+     *
+     * The strings longer than the maximum size of the current value are rejected before they are copied.
+     */
+    attribute_data_decode_buffer(const esp_matter_attr_val_t &current_val)
+        : attribute_data_decode_buffer(current_val.type)
     {
-        if (m_attr_val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-            m_attr_val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
-            m_attr_val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-            m_attr_val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING) {
-            if (m_attr_val.val.a.b) {
-                esp_matter_mem_free(m_attr_val.val.a.b);
-            }
+        if (is_string_type(current_val.type)) {
+            m_max_size = current_val.val.a.max;
         }
     }
 
+    ~attribute_data_decode_buffer();
+
+    /** The decoded value
+     *
+     * A decoded string is only valid as long as this buffer and the TLV data it was decoded from: an octet string
+     * points to the TLV data when it is contiguous, a short char string is copied to a buffer inside this object with a
+     * null terminator. The attribute storage copies it once.
+     */
     esp_matter_attr_val_t &get_attr_val() { return m_attr_val; }
 
     CHIP_ERROR Decode(chip::TLV::TLVReader &reader);
 
 private:
+    static bool is_string_type(esp_matter_val_type_t type)
+    {
+        return type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+            type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING;
+    }
+
     esp_matter_attr_val_t m_attr_val;
+    uint16_t m_max_size = UINT16_MAX;
+    /* Buffer allocated by Decode() when the string could not be decoded in place or in m_string */
+    uint8_t *m_allocated = nullptr;
+    /* Char strings shorter than this, like the labels and names, are decoded here with their null terminator */
+    char m_string[64];
 };
 } // namespace data_model
 } // namespace esp_matter
@@ -19,6 +19,8 @@
 #include <esp_matter_data_model.h>
 #include <esp_matter_data_model_priv.h>
 #include <esp_matter_data_model_provider.h>
+#include <esp_matter_metadata_cache.h>
+#include <esp_matter_sealed_model.h>
 
 #include <access/Privilege.h>
 #include <app-common/zap-generated/cluster-objects.h>
@@ -218,12 +220,25 @@ size_t get_attribute_count(esp_matter::cluster_t *cluster)
     return ret;
 }
 
+using esp_matter::metadata_cache::make_accepted_command_entry;
+using esp_matter::metadata_cache::make_attribute_entry;
+
 DefaultAttributePersistenceProvider gDefaultAttributePersistence;
 } // anonymous namespace
 
 namespace esp_matter {
 namespace data_model {
 
+struct provider::resolved_path {
+    chip::app::ServerClusterInterface *server_cluster = nullptr;
+    endpoint_t *endpoint = nullptr;
+    cluster_t *cluster = nullptr;
+    attribute_t *attribute = nullptr;
+    // Accepted command of a command path, nullptr if the command is only generated
+    command_t *command = nullptr;
+    AttributeAccessInterface *aai = nullptr;
+};
+
 provider &provider::get_instance()
 {
     static provider instance;
@@ -277,50 +292,45 @@ CHIP_ERROR provider::Shutdown()
 
 ActionReturnStatus provider::ReadAttribute(const ReadAttributeRequest &request, AttributeValueEncoder &encoder)
 {
-    if (auto *cluster = mRegistry.Get(request.path); cluster != nullptr) {
-        return cluster->ReadAttribute(request, encoder);
-    }
-    Status status = CheckDataModelPath(request.path);
+    resolved_path resolved;
+    Status status = ResolvePath(request.path, resolved);
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
-    attribute_t *attribute =
-        attribute::get(request.path.mEndpointId, request.path.mClusterId, request.path.mAttributeId);
+    if (resolved.server_cluster) {
+        return resolved.server_cluster->ReadAttribute(request, encoder);
+    }
 
-    std::optional<CHIP_ERROR> aai_result = TryReadViaAccessInterface(
-        request.path,
-        AttributeAccessInterfaceRegistry::Instance().Get(request.path.mEndpointId, request.path.mClusterId), encoder);
+    std::optional<CHIP_ERROR> aai_result = TryReadViaAccessInterface(request.path, resolved.aai, encoder);
     VerifyOrReturnError(!aai_result.has_value(), *aai_result);
 
     esp_matter_attr_val_t val = esp_matter_invalid(nullptr);
-    VerifyOrReturnValue(attribute::get_val_internal(attribute, &val) == ESP_OK, Protocols::InteractionModel::Status::Failure);
+    VerifyOrReturnValue(attribute::get_val_internal(resolved.attribute, &val) == ESP_OK,
+                        Protocols::InteractionModel::Status::Failure);
     attribute_data_encode_buffer data_buffer(val);
     return encoder.Encode(data_buffer);
 }
 
 ActionReturnStatus provider::WriteAttribute(const WriteAttributeRequest &request, AttributeValueDecoder &decoder)
 {
-    if (auto *cluster = mRegistry.Get(request.path); cluster != nullptr) {
-        return cluster->WriteAttribute(request, decoder);
-    }
-    Status status = CheckDataModelPath(request.path);
+    resolved_path resolved;
+    Status status = ResolvePath(request.path, resolved);
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
-    cluster_t *cluster = cluster::get(request.path.mEndpointId, request.path.mClusterId);
-    attribute_t *attribute = attribute::get(cluster, request.path.mAttributeId);
+    if (resolved.server_cluster) {
+        return resolved.server_cluster->WriteAttribute(request, decoder);
+    }
     if (request.path.mDataVersion.HasValue()) {
         chip::DataVersion data_version;
-        VerifyOrReturnValue(cluster::get_data_version(cluster, data_version) == ESP_OK,
+        VerifyOrReturnValue(cluster::get_data_version(resolved.cluster, data_version) == ESP_OK,
                             Protocols::InteractionModel::Status::DataVersionMismatch);
         VerifyOrReturnValue(data_version == request.path.mDataVersion.Value(),
                             Protocols::InteractionModel::Status::DataVersionMismatch);
     }
 
-    AttributeAccessInterface *aai =
-        AttributeAccessInterfaceRegistry::Instance().Get(request.path.mEndpointId, request.path.mClusterId);
-    std::optional<CHIP_ERROR> aai_result = TryWriteViaAccessInterface(request.path, aai, decoder);
+    std::optional<CHIP_ERROR> aai_result = TryWriteViaAccessInterface(request.path, resolved.aai, decoder);
     if (aai_result.has_value()) {
         if (*aai_result == CHIP_NO_ERROR) {
-            cluster::increase_data_version(cluster);
+            cluster::increase_data_version(resolved.cluster);
             AttributePathParams path(request.path.mEndpointId, request.path.mClusterId, request.path.mAttributeId);
             mContext->dataModelChangeListener.MarkDirty(path);
         }
@@ -328,11 +338,13 @@ ActionReturnStatus provider::WriteAttribute(const WriteAttributeRequest &request
     }
 
     esp_matter_attr_val_t val = esp_matter_invalid(nullptr);
-    VerifyOrReturnValue(attribute::get_val_internal(attribute, &val) == ESP_OK, Protocols::InteractionModel::Status::Failure);
-    attribute_data_decode_buffer data_buffer(val.type);
+    VerifyOrReturnValue(attribute::get_val_internal(resolved.attribute, &val) == ESP_OK,
+                        Protocols::InteractionModel::Status::Failure);
+    attribute_data_decode_buffer data_buffer(val);
     ReturnErrorOnFailure(decoder.Decode(data_buffer));
-    esp_err_t err =
-        attribute::update(request.path.mEndpointId, request.path.mClusterId, request.path.mAttributeId, &data_buffer.get_attr_val());
+    // The reporting policy only applies to the updates of the application, a client write is always reported
+    esp_err_t err = attribute::update_internal(resolved.attribute, request.path.mEndpointId, request.path.mClusterId,
+                                               request.path.mAttributeId, &data_buffer.get_attr_val(), false);
     if (err == ESP_ERR_NO_MEM) {
         return Protocols::InteractionModel::Status::ResourceExhausted;
     } else if (err != ESP_OK) {
@@ -369,12 +381,13 @@ std::optional<ActionReturnStatus> provider::InvokeCommand(const InvokeRequest &r
                                                           chip::TLV::TLVReader &input_arguments,
                                                           CommandHandler *handler)
 {
-    if (auto *cluster = mRegistry.Get(request.path); cluster != nullptr) {
-        return cluster->InvokeCommand(request, input_arguments, handler);
-    }
-    Status status = CheckDataModelPath(request.path);
+    resolved_path resolved;
+    Status status = ResolvePath(request.path, resolved);
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
+    if (resolved.server_cluster) {
+        return resolved.server_cluster->InvokeCommand(request, input_arguments, handler);
+    }
     CommandHandlerInterface *handler_interface = CommandHandlerInterfaceRegistry::Instance().GetCommandHandler(
         request.path.mEndpointId, request.path.mClusterId);
 
@@ -388,7 +401,7 @@ std::optional<ActionReturnStatus> provider::InvokeCommand(const InvokeRequest &r
         }
     }
 
-    command::dispatch_single_cluster_command(request.path, input_arguments, handler);
+    command::dispatch_single_cluster_command(resolved.command, request.path, input_arguments, handler);
     return std::nullopt;
 }
 
@@ -452,22 +465,35 @@ CHIP_ERROR provider::ServerClusters(EndpointId endpointId, ReadOnlyBufferBuilder
     Status status = CheckDataModelPath(endpointId);
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
+    auto append_entry = [&](cluster_t *cluster, ClusterId cluster_id) -> CHIP_ERROR {
+        ServerClusterEntry entry;
+        entry.clusterId = cluster_id;
+        if (auto *server_cluster = mRegistry.Get(ConcreteClusterPath(endpointId, entry.clusterId)); server_cluster != nullptr) {
+            entry.flags = server_cluster->GetClusterFlags(ConcreteClusterPath(endpointId, entry.clusterId));
+            entry.dataVersion = server_cluster->GetDataVersion(ConcreteClusterPath(endpointId, entry.clusterId));
+        } else {
+            entry.flags.ClearAll();
+            VerifyOrReturnError(cluster::get_data_version(cluster, entry.dataVersion) == ESP_OK, CHIP_ERROR_INTERNAL);
+        }
+        return builder.Append(entry);
+    };
+    sealed_model::endpoint_view_t view;
+    if (sealed_model::get_endpoint(endpointId, &view)) {
+        ReturnErrorOnFailure(builder.EnsureAppendCapacity(view.count));
+        for (size_t index = 0; index < view.count; ++index) {
+            if (view.cluster_flags[index] & CLUSTER_FLAG_SERVER) {
+                ReturnErrorOnFailure(append_entry(view.clusters[index], view.cluster_ids[index]));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
     endpoint_t *ep = endpoint::get(endpointId);
     size_t count = endpoint::get_cluster_count(endpointId, chip::kInvalidClusterId, CLUSTER_FLAG_SERVER);
     ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
     cluster_t *cluster = cluster::get_first(ep);
     while (cluster) {
         if (cluster::get_flags(cluster) & CLUSTER_FLAG_SERVER) {
-            ServerClusterEntry entry;
-            entry.clusterId = cluster::get_id(cluster);
-            if (auto *server_cluster = mRegistry.Get(ConcreteClusterPath(endpointId, entry.clusterId)); server_cluster != nullptr) {
-                entry.flags = server_cluster->GetClusterFlags(ConcreteClusterPath(endpointId, entry.clusterId));
-                entry.dataVersion = server_cluster->GetDataVersion(ConcreteClusterPath(endpointId, entry.clusterId));
-            } else {
-                entry.flags.ClearAll();
-                VerifyOrReturnError(cluster::get_data_version(cluster, entry.dataVersion) == ESP_OK, CHIP_ERROR_INTERNAL);
-            }
-            ReturnErrorOnFailure(builder.Append(entry));
+            ReturnErrorOnFailure(append_entry(cluster, cluster::get_id(cluster)));
         }
         cluster = cluster::get_next(cluster);
     }
@@ -503,8 +529,22 @@ CHIP_ERROR provider::GeneratedCommands(const ConcreteClusterPath &path, ReadOnly
     Status status = CheckDataModelPath(path);
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
+    sealed_model::cluster_view_t view;
+    if (sealed_model::get_cluster(path.mEndpointId, path.mClusterId, &view)) {
+        // The command ids are packed, copy them at once
+        return builder.AppendElements(Span<const CommandId>(view.generated_command_ids, view.generated_command_count));
+    }
     cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
-    size_t count = get_command_count(cluster, COMMAND_FLAG_GENERATED);
+    command_t *const *commands;
+    size_t count;
+    if (command::get_sorted(cluster, COMMAND_FLAG_GENERATED, &commands, &count) == ESP_OK) {
+        ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
+        for (size_t index = 0; index < count; ++index) {
+            ReturnErrorOnFailure(builder.Append(command::get_id(commands[index])));
+        }
+        return CHIP_NO_ERROR;
+    }
+    count = get_command_count(cluster, COMMAND_FLAG_GENERATED);
     ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
     command_t *command = command::get_first(cluster);
     while (command) {
@@ -534,35 +574,42 @@ CHIP_ERROR provider::AcceptedCommands(const ConcreteClusterPath &path,
         VerifyOrReturnError(err == CHIP_ERROR_NOT_IMPLEMENTED, err);
     }
     // If we cannot get AcceptedCommands array from CommandHandlerinterface, get it from esp_matter data model.
+    sealed_model::cluster_view_t view;
+    if (sealed_model::get_cluster(path.mEndpointId, path.mClusterId, &view)) {
+        Span<const AcceptedCommandEntry> entries;
+        if (metadata_cache::get_accepted_commands(path.mClusterId, view, &entries)) {
+            return builder.AppendElements(entries);
+        }
+        ReturnErrorOnFailure(builder.EnsureAppendCapacity(view.accepted_command_count));
+        for (size_t index = 0; index < view.accepted_command_count; ++index) {
+            ReturnErrorOnFailure(
+                builder.Append(make_accepted_command_entry(path.mClusterId, view.accepted_command_ids[index])));
+        }
+        return CHIP_NO_ERROR;
+    }
     cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
-    size_t count = get_command_count(cluster, COMMAND_FLAG_ACCEPTED);
+    command_t *const *commands;
+    size_t count;
+    if (command::get_sorted(cluster, COMMAND_FLAG_ACCEPTED, &commands, &count) == ESP_OK) {
+        ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
+        for (size_t index = 0; index < count; ++index) {
+            ReturnErrorOnFailure(
+                builder.Append(make_accepted_command_entry(path.mClusterId, command::get_id(commands[index]))));
+        }
+        return CHIP_NO_ERROR;
+    }
+    count = get_command_count(cluster, COMMAND_FLAG_ACCEPTED);
     ReturnErrorOnFailure(builder.EnsureAppendCapacity(count));
     command_t *command = command::get_first(cluster);
     while (command) {
         if (command::get_flags(command) & COMMAND_FLAG_ACCEPTED) {
-            uint32_t command_id = command::get_id(command);
-            BitMask<DataModel::CommandQualityFlags> quality_flags;
-            quality_flags
-                .Set(DataModel::CommandQualityFlags::kFabricScoped, CommandIsFabricScoped(path.mClusterId, command_id))
-                .Set(DataModel::CommandQualityFlags::kTimed, CommandNeedsTimedInvoke(path.mClusterId, command_id))
-                .Set(DataModel::CommandQualityFlags::kLargeMessage,
-                     CommandHasLargePayload(path.mClusterId, command_id));
-            AcceptedCommandEntry entry(command_id, quality_flags,
-                                       MatterGetAccessPrivilegeForInvokeCommand(path.mClusterId, command_id));
-            ReturnErrorOnFailure(builder.Append(entry));
+            ReturnErrorOnFailure(builder.Append(make_accepted_command_entry(path.mClusterId, command::get_id(command))));
         }
         command = command::get_next(command);
     }
     return CHIP_NO_ERROR;
 }
 
-static constexpr AttributeId k_global_attributes_not_in_metadata[] = {
-    Clusters::Globals::Attributes::AttributeList::Id, Clusters::Globals::Attributes::AcceptedCommandList::Id,
-    Clusters::Globals::Attributes::GeneratedCommandList::Id};
-
-static constexpr size_t k_global_attributes_count =
-    sizeof(k_global_attributes_not_in_metadata) / sizeof(k_global_attributes_not_in_metadata[0]);
-
 CHIP_ERROR provider::Attributes(const ConcreteClusterPath &path, ReadOnlyBufferBuilder<AttributeEntry> &builder)
 {
     if (auto *cluster = mRegistry.Get(path); cluster != nullptr) {
@@ -571,36 +618,34 @@ CHIP_ERROR provider::Attributes(const ConcreteClusterPath &path, ReadOnlyBufferB
     Status status = CheckDataModelPath(path);
     VerifyOrReturnValue(status == Protocols::InteractionModel::Status::Success,
                         CHIP_ERROR_IM_GLOBAL_STATUS_VALUE(status));
-    cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
-    size_t count = get_attribute_count(cluster);
     // There are three attributes(Attributes, AcceptedCommands, and GeneratedCommands) which are not
     // in esp_matter data model metadata;
-    ReturnErrorOnFailure(builder.EnsureAppendCapacity(count + k_global_attributes_count));
-    attribute_t *attribute = attribute::get_first(cluster);
-    while (attribute) {
-        uint32_t id = attribute::get_id(attribute);
-        uint16_t flags = attribute::get_flags(attribute);
-        chip::BitFlags<DataModel::AttributeQualityFlags> attr_quality_flags;
-        // TODO Array
-        attr_quality_flags.Set(DataModel::AttributeQualityFlags::kTimed, flags & ATTRIBUTE_FLAG_MUST_USE_TIMED_WRITE);
-        chip::Access::Privilege read_privilege = MatterGetAccessPrivilegeForReadAttribute(path.mClusterId, id);
-        auto write_privilege = (flags & ATTRIBUTE_FLAG_WRITABLE)
-            ? std::make_optional(MatterGetAccessPrivilegeForWriteAttribute(path.mClusterId, id))
-            : std::nullopt;
-        AttributeEntry entry(id, attr_quality_flags, read_privilege, write_privilege);
-        ReturnErrorOnFailure(builder.Append(entry));
-        attribute = attribute::get_next(attribute);
+    Span<const AttributeEntry> globals = metadata_cache::get_global_attributes();
+    sealed_model::cluster_view_t view;
+    if (sealed_model::get_cluster(path.mEndpointId, path.mClusterId, &view)) {
+        // The cached entries already end with the global attributes
+        Span<const AttributeEntry> entries;
+        if (metadata_cache::get_attributes(path.mClusterId, view, &entries)) {
+            return builder.AppendElements(entries);
+        }
+        ReturnErrorOnFailure(builder.EnsureAppendCapacity(view.attribute_count + globals.size()));
+        for (size_t index = 0; index < view.attribute_count; ++index) {
+            ReturnErrorOnFailure(builder.Append(
+                make_attribute_entry(path.mClusterId, view.attribute_ids[index], view.attribute_flags[index])));
+        }
+    } else {
+        cluster_t *cluster = cluster::get(path.mEndpointId, path.mClusterId);
+        size_t count = get_attribute_count(cluster);
+        ReturnErrorOnFailure(builder.EnsureAppendCapacity(count + globals.size()));
+        attribute_t *attribute = attribute::get_first(cluster);
+        while (attribute) {
+            ReturnErrorOnFailure(builder.Append(make_attribute_entry(path.mClusterId, attribute::get_id(attribute),
+                                                                     attribute::get_flags(attribute))));
+            attribute = attribute::get_next(attribute);
+        }
     }
     // Append the three Global attributes
-    for (size_t index = 0; index < k_global_attributes_count; ++index)
-    {
-        AttributeEntry entry(k_global_attributes_not_in_metadata[index],
-                         chip::BitFlags<DataModel::AttributeQualityFlags>(), chip::Access::Privilege::kView,
-                         std::nullopt);
-        ReturnErrorOnFailure(builder.Append(entry));
-    }
-
-    return CHIP_NO_ERROR;
+    return builder.AppendElements(globals);
 }
 
 void provider::Temporary_ReportAttributeChanged(const AttributePathParams &path)
@@ -627,36 +672,46 @@ Status provider::CheckDataModelPath(const ConcreteClusterPath &path)
     return Protocols::InteractionModel::Status::Success;
 }
 
-Status provider::CheckDataModelPath(const ConcreteAttributePath &path)
+Status provider::CheckDataModelPath(const ConcreteEventPath &path)
 {
     endpoint_t *endpoint = endpoint::get(path.mEndpointId);
     VerifyOrReturnValue(endpoint, Protocols::InteractionModel::Status::UnsupportedEndpoint);
     cluster_t *cluster = cluster::get(endpoint, path.mClusterId);
     VerifyOrReturnValue(cluster != nullptr, Protocols::InteractionModel::Status::UnsupportedCluster);
-    attribute_t *attribute = attribute::get(cluster, path.mAttributeId);
-    VerifyOrReturnValue(attribute != nullptr, Protocols::InteractionModel::Status::UnsupportedAttribute);
+    event_t *event = event::get(cluster, path.mEventId);
+    VerifyOrReturnValue(event != nullptr, Protocols::InteractionModel::Status::UnsupportedEvent);
     return Protocols::InteractionModel::Status::Success;
 }
 
-Status provider::CheckDataModelPath(const ConcreteEventPath &path)
+Status provider::ResolvePath(const ConcreteAttributePath &path, resolved_path &resolved)
 {
-    endpoint_t *endpoint = endpoint::get(path.mEndpointId);
-    VerifyOrReturnValue(endpoint, Protocols::InteractionModel::Status::UnsupportedEndpoint);
-    cluster_t *cluster = cluster::get(endpoint, path.mClusterId);
-    VerifyOrReturnValue(cluster != nullptr, Protocols::InteractionModel::Status::UnsupportedCluster);
-    event_t *event = event::get(cluster, path.mEventId);
-    VerifyOrReturnValue(event != nullptr, Protocols::InteractionModel::Status::UnsupportedEvent);
+    resolved = resolved_path();
+    resolved.server_cluster = mRegistry.Get(path);
+    VerifyOrReturnValue(resolved.server_cluster == nullptr, Protocols::InteractionModel::Status::Success);
+    resolved.endpoint = endpoint::get(path.mEndpointId);
+    VerifyOrReturnValue(resolved.endpoint, Protocols::InteractionModel::Status::UnsupportedEndpoint);
+    resolved.cluster = cluster::get(resolved.endpoint, path.mClusterId);
+    VerifyOrReturnValue(resolved.cluster != nullptr, Protocols::InteractionModel::Status::UnsupportedCluster);
+    resolved.attribute = attribute::get(resolved.cluster, path.mAttributeId);
+    VerifyOrReturnValue(resolved.attribute != nullptr, Protocols::InteractionModel::Status::UnsupportedAttribute);
+    resolved.aai = AttributeAccessInterfaceRegistry::Instance().Get(path.mEndpointId, path.mClusterId);
     return Protocols::InteractionModel::Status::Success;
 }
 
-Status provider::CheckDataModelPath(const chip::app::ConcreteCommandPath path)
+Status provider::ResolvePath(const chip::app::ConcreteCommandPath &path, resolved_path &resolved)
 {
-    endpoint_t *endpoint = endpoint::get(path.mEndpointId);
-    VerifyOrReturnValue(endpoint, Protocols::InteractionModel::Status::UnsupportedEndpoint);
-    cluster_t *cluster = cluster::get(endpoint, path.mClusterId);
-    VerifyOrReturnValue(cluster != nullptr, Protocols::InteractionModel::Status::UnsupportedCluster);
-    command_t *command = command::get(cluster, path.mCommandId, COMMAND_FLAG_ACCEPTED | COMMAND_FLAG_GENERATED);
-    VerifyOrReturnValue(command != nullptr, Protocols::InteractionModel::Status::UnsupportedCommand);
+    resolved = resolved_path();
+    resolved.server_cluster = mRegistry.Get(path);
+    VerifyOrReturnValue(resolved.server_cluster == nullptr, Protocols::InteractionModel::Status::Success);
+    resolved.endpoint = endpoint::get(path.mEndpointId);
+    VerifyOrReturnValue(resolved.endpoint, Protocols::InteractionModel::Status::UnsupportedEndpoint);
+    resolved.cluster = cluster::get(resolved.endpoint, path.mClusterId);
+    VerifyOrReturnValue(resolved.cluster != nullptr, Protocols::InteractionModel::Status::UnsupportedCluster);
+    // The accepted command is the one dispatched, a generated command only makes the path valid
+    resolved.command = command::get(resolved.cluster, path.mCommandId, COMMAND_FLAG_ACCEPTED);
+    VerifyOrReturnValue(resolved.command != nullptr ||
+                            command::get(resolved.cluster, path.mCommandId, COMMAND_FLAG_GENERATED) != nullptr,
+                        Protocols::InteractionModel::Status::UnsupportedCommand);
     return Protocols::InteractionModel::Status::Success;
 }
 
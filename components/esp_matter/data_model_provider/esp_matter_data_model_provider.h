@@ -99,11 +99,15 @@ public:
     void Temporary_ReportAttributeChanged(const AttributePathParams &path) override;
 
 private:
+    /// Objects of a request path, resolved once and reused by every stage of the request
+    struct resolved_path;
+
+    Status ResolvePath(const ConcreteAttributePath &path, resolved_path &resolved);
+    Status ResolvePath(const chip::app::ConcreteCommandPath &path, resolved_path &resolved);
+
     Status CheckDataModelPath(EndpointId endpointId);
     Status CheckDataModelPath(const ConcreteClusterPath &path);
-    Status CheckDataModelPath(const ConcreteAttributePath &path);
     Status CheckDataModelPath(const ConcreteEventPath &path);
-    Status CheckDataModelPath(const chip::app::ConcreteCommandPath path);
 
     chip::app::ServerClusterInterfaceRegistry mRegistry;
     std::optional<chip::app::DataModel::InteractionModelContext> mContext;
@@ -20,6 +20,7 @@
 #include <esp_matter_attribute_utils.h>
 #include <esp_matter_data_model.h>
 #include <esp_matter_data_model_priv.h>
+#include <esp_matter_endpoint_table.h>
 
 #include <app-common/zap-generated/attribute-type.h>
 #include <app/AttributePathParams.h>
@@ -39,7 +40,11 @@ namespace {
 
 esp_matter::endpoint_t *get_endpoint_at_index(uint16_t index)
 {
-    esp_matter::endpoint_t *ep = esp_matter::endpoint::get_first(esp_matter::node::get());
+    esp_matter::endpoint_t *ep = nullptr;
+    if (esp_matter::endpoint_table::get_at(index, &ep)) {
+        return ep;
+    }
+    ep = esp_matter::endpoint::get_first(esp_matter::node::get());
     uint16_t idx = 0;
     while (idx < index && ep) {
         ep = esp_matter::endpoint::get_next(ep);
@@ -755,6 +760,11 @@ EnabledEndpointsWithServerCluster &EnabledEndpointsWithServerCluster::operator++
 
 void EnabledEndpointsWithServerCluster::EnsureMatchingEndpoint()
 {
+    uint16_t index;
+    if (esp_matter::endpoint_table::find_next(mClusterId, mEndpointIndex, &index)) {
+        mEndpointIndex = index < mEndpointCount ? index : mEndpointCount;
+        return;
+    }
     for (; mEndpointIndex < mEndpointCount; ++mEndpointIndex) {
         esp_matter::endpoint_t *ep = get_endpoint_at_index(mEndpointIndex);
         if (!esp_matter::endpoint::is_enabled(ep)) {
@@ -945,6 +955,10 @@ uint8_t emberAfGetClustersFromEndpoint(chip::EndpointId endpoint, chip::ClusterI
 uint16_t emberAfGetClusterServerEndpointIndex(chip::EndpointId endpoint, chip::ClusterId clusterId,
                                               uint16_t fixedClusterServerEndpointCount)
 {
+    uint16_t rank;
+    if (esp_matter::endpoint_table::get_cluster_rank(endpoint, clusterId, &rank)) {
+        return rank;
+    }
     esp_matter::endpoint_t *ep = esp_matter::endpoint::get(endpoint);
     if (ep) {
         esp_matter::cluster_t *cluster = esp_matter::cluster::get(ep, clusterId);
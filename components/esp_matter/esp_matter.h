@@ -22,6 +22,8 @@ application.
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
 #ifdef CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
 #include <esp_matter_attribute.h>
+#include <esp_matter_attribute_handle.h>
+#include <esp_matter_attribute_queue.h>
 #include <esp_matter_attribute_utils.h>
 #include <esp_matter_cluster.h>
 #include <esp_matter_command.h>
@@ -29,6 +31,7 @@ application.
 #include <esp_matter_event.h>
 #include <esp_matter_feature.h>
 #include <esp_matter_data_model.h>
+#include <esp_matter_static_node.h>
 #endif // CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
 #include <app/server/Dnssd.h>
 #include <esp_matter_identify.h>
@@ -12,23 +12,32 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <esp_check.h>
 #include <esp_log.h>
 #include <esp_matter.h>
 #include <esp_matter_core.h>
 #include <esp_matter_icd_configuration.h>
 #include <esp_matter_test_event_trigger.h>
+#include <esp_timer.h>
+#include <freertos/semphr.h>
 #include <nvs.h>
 #include <nvs_flash.h>
+#include <string.h>
 
 #include <app/server/Dnssd.h>
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
 #include <app/server/Server.h>
+#if CHIP_CONFIG_ENABLE_ICD_SERVER
+#include <app/icd/server/ICDStateObserver.h>
+#endif
 #include <esp_matter_ota.h>
 #ifdef CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
 #include <esp_matter_nvs.h>
 #include <data_model_provider/esp_matter_data_model_provider.h>
 #include <esp_matter_data_model_priv.h>
+#include <esp_matter_write_behind.h>
 #else
 #include <data-model-providers/codegen/Instance.h>
 #endif // CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
@@ -136,35 +145,168 @@ AppDelegateImpl s_app_delegate;
 
 FabricDelegateImpl s_fabric_delegate;
 
+#if CHIP_CONFIG_ENABLE_ICD_SERVER && defined(CONFIG_ESP_MATTER_NVS_WRITE_BEHIND) && \
+    defined(CONFIG_ESP_MATTER_ENABLE_DATA_MODEL)
+class ICDObserverImpl : public chip::app::ICDStateObserver
+{
+public:
+    void OnEnterActiveMode() {}
+
+    void OnTransitionToIdle()
+    {
+        // Write the dirty attributes while the device is still awake
+        write_behind::flush();
+    }
+
+    void OnEnterIdleMode() {}
+
+    void OnICDModeChange() {}
+};
+
+ICDObserverImpl s_icd_observer;
+#endif
+
 }  // namespace
 #endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
 
 namespace lock {
 #define DEFAULT_TICKS (500 / portTICK_PERIOD_MS) /* 500 ms in ticks */
+#define MAX_WAIT_SLICE_TICKS (10 / portTICK_PERIOD_MS > 0 ? 10 / portTICK_PERIOD_MS : 1) /* 10 ms in ticks */
+
+/* The statistics are updated by the task which holds the chip stack lock, the critical section orders the updates
+ * against get_stats() and reset_stats() */
+static stats_t s_stats;
+static int64_t s_acquired_time_us = 0;
+static std::atomic<uint32_t> s_timeouts{0};
+static portMUX_TYPE s_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+/* Number of tasks waiting in chip_stack_lock(), chip_stack_unlock() wakes one of them when it is not 0 */
+static std::atomic<uint32_t> s_waiters{0};
+
+static SemaphoreHandle_t get_release_semaphore()
+{
+    static StaticSemaphore_t s_release_semaphore_storage;
+    static SemaphoreHandle_t s_release_semaphore = xSemaphoreCreateBinaryStatic(&s_release_semaphore_storage);
+    return s_release_semaphore;
+}
+
+static uint8_t get_histogram_bucket(uint32_t time_us)
+{
+    uint8_t bucket = 0;
+    while (time_us > histogram_bucket_limits_us[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+static void record_acquisition(int64_t wait_start_us)
+{
+    int64_t acquired_time_us = esp_timer_get_time();
+    uint32_t wait_us = (uint32_t)std::min<int64_t>(acquired_time_us - wait_start_us, UINT32_MAX);
+    taskENTER_CRITICAL(&s_stats_mux);
+    s_acquired_time_us = acquired_time_us;
+    s_stats.acquisitions++;
+    s_stats.wait_histogram[get_histogram_bucket(wait_us)]++;
+    s_stats.max_wait_us = std::max(s_stats.max_wait_us, wait_us);
+    s_stats.holder = xTaskGetCurrentTaskHandle();
+    taskEXIT_CRITICAL(&s_stats_mux);
+}
+
+static void record_release()
+{
+    int64_t release_time_us = esp_timer_get_time();
+    taskENTER_CRITICAL(&s_stats_mux);
+    if (s_stats.holder == xTaskGetCurrentTaskHandle() && s_acquired_time_us != 0) {
+        uint32_t hold_us = (uint32_t)std::min<int64_t>(release_time_us - s_acquired_time_us, UINT32_MAX);
+        s_stats.hold_histogram[get_histogram_bucket(hold_us)]++;
+        if (hold_us > s_stats.max_hold_us) {
+            s_stats.max_hold_us = hold_us;
+            strlcpy(s_stats.max_hold_task, pcTaskGetName(NULL), sizeof(s_stats.max_hold_task));
+        }
+    }
+    s_stats.holder = NULL;
+    s_acquired_time_us = 0;
+    taskEXIT_CRITICAL(&s_stats_mux);
+}
+
+static bool is_held_through_api()
+{
+    taskENTER_CRITICAL(&s_stats_mux);
+    bool held = s_stats.holder != NULL;
+    taskEXIT_CRITICAL(&s_stats_mux);
+    return held;
+}
+
 status_t chip_stack_lock(uint32_t ticks_to_wait)
 {
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     VerifyOrReturnValue(!PlatformMgr().IsChipStackLockedByCurrentThread(), ALREADY_TAKEN);
 #endif
-    VerifyOrReturnValue(ticks_to_wait != portMAX_DELAY, SUCCESS, PlatformMgr().LockChipStack());
-    uint32_t ticks_remaining = ticks_to_wait;
-    uint32_t ticks = DEFAULT_TICKS;
-    while (ticks_remaining > 0) {
-        VerifyOrReturnValue(!PlatformMgr().TryLockChipStack(), SUCCESS);
-        ticks = ticks_remaining < DEFAULT_TICKS ? ticks_remaining : DEFAULT_TICKS;
-        ticks_remaining -= ticks;
-        ESP_LOGI(TAG, "Did not get lock yet. Retrying...");
-        vTaskDelay(ticks);
+    int64_t wait_start_us = esp_timer_get_time();
+    if (ticks_to_wait == portMAX_DELAY) {
+        PlatformMgr().LockChipStack();
+        record_acquisition(wait_start_us);
+        return SUCCESS;
+    }
+    // The platform manager has no timed lock. The waiters block on a semaphore which chip_stack_unlock() gives, and
+    // which wakes the waiter with the highest priority first. The Matter thread releases the lock without giving it,
+    // so while the lock is not held through this API the waiters check it again on every tick.
+    SemaphoreHandle_t release_semaphore = get_release_semaphore();
+    TickType_t start_ticks = xTaskGetTickCount();
+    bool logged = false;
+    s_waiters.fetch_add(1, std::memory_order_acq_rel);
+    while (true) {
+        if (PlatformMgr().TryLockChipStack()) {
+            s_waiters.fetch_sub(1, std::memory_order_acq_rel);
+            record_acquisition(wait_start_us);
+            return SUCCESS;
+        }
+        TickType_t elapsed_ticks = xTaskGetTickCount() - start_ticks;
+        if (elapsed_ticks >= ticks_to_wait) {
+            break;
+        }
+        if (!logged && elapsed_ticks >= DEFAULT_TICKS) {
+            ESP_LOGI(TAG, "Did not get lock yet. Retrying...");
+            logged = true;
+        }
+        // The slice bounds the wait when the wake-up went to another waiter which then lost the lock
+        TickType_t slice_ticks = is_held_through_api() ? MAX_WAIT_SLICE_TICKS : 1;
+        xSemaphoreTake(release_semaphore, std::min<TickType_t>(slice_ticks, ticks_to_wait - elapsed_ticks));
     }
+    s_waiters.fetch_sub(1, std::memory_order_acq_rel);
+    s_timeouts.fetch_add(1, std::memory_order_relaxed);
     ESP_LOGE(TAG, "Could not get lock");
     return FAILED;
 }
 
 esp_err_t chip_stack_unlock()
 {
+    record_release();
     PlatformMgr().UnlockChipStack();
+    if (s_waiters.load(std::memory_order_acquire) > 0) {
+        xSemaphoreGive(get_release_semaphore());
+    }
     return ESP_OK;
 }
+
+esp_err_t get_stats(stats_t *stats)
+{
+    VerifyOrReturnError(stats, ESP_ERR_INVALID_ARG, ESP_LOGE(TAG, "stats cannot be NULL"));
+    taskENTER_CRITICAL(&s_stats_mux);
+    *stats = s_stats;
+    taskEXIT_CRITICAL(&s_stats_mux);
+    stats->timeouts = s_timeouts.load(std::memory_order_relaxed);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    taskENTER_CRITICAL(&s_stats_mux);
+    TaskHandle_t holder = s_stats.holder;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.holder = holder;
+    taskEXIT_CRITICAL(&s_stats_mux);
+    s_timeouts.store(0, std::memory_order_relaxed);
+}
 } /* lock */
 
 #ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
@@ -240,6 +382,11 @@ static void esp_matter_chip_init_task(intptr_t context)
         }
         chip::Server::GetInstance().GetICDManager().Shutdown();
     }
+#if defined(CONFIG_ESP_MATTER_NVS_WRITE_BEHIND) && defined(CONFIG_ESP_MATTER_ENABLE_DATA_MODEL)
+    else {
+        chip::Server::GetInstance().GetICDManager().RegisterObserver(&s_icd_observer);
+    }
+#endif
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
     PlatformMgr().ScheduleWork(deinit_ble_if_commissioned, reinterpret_cast<intptr_t>(nullptr));
     xTaskNotifyGive(task_to_notify);
@@ -358,6 +505,8 @@ esp_err_t start(event_callback_t callback, intptr_t callback_arg)
     VerifyOrReturnError(chip::DeviceLayer::Internal::ESP32Utils::InitWiFiStack() == CHIP_NO_ERROR, ESP_FAIL, ESP_LOGE(TAG, "Error initializing Wi-Fi stack"));
 #endif // CHIP_DEVICE_CONFIG_ENABLE_WIFI
 #ifdef CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+    // The endpoints created so far have read their non-volatile attributes
+    attribute::end_nvs_restore();
     esp_matter_ota_requestor_init();
 #endif // CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
 
@@ -381,6 +530,14 @@ esp_err_t start(event_callback_t callback, intptr_t callback_arg)
         err = node::store_min_unused_endpoint_id();
     }
 #endif // defined(CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER) && defined(CONFIG_ESP_MATTER_ENABLE_DATA_MODEL)
+#if defined(CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER) && defined(CONFIG_ESP_MATTER_DATA_MODEL_AUTO_SEAL)
+    // Seal the node on the Matter thread, so that the tables are not built while the stack is reading them
+    PlatformMgr().ScheduleWork([](intptr_t) {
+        if (node::seal() != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to seal the node, the data model lists will be used");
+        }
+    }, reinterpret_cast<intptr_t>(nullptr));
+#endif // defined(CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER) && defined(CONFIG_ESP_MATTER_DATA_MODEL_AUTO_SEAL)
     return err;
 }
 
@@ -391,6 +548,12 @@ esp_err_t factory_reset()
     node_t *node = node::get();
     if (node) {
         /* ESP Matter data model is used. Erase all the data that we have added in nvs. */
+        /* The dirty attributes are erased anyway, so drop them instead of writing them. */
+        lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+        write_behind::reset();
+        if (lock_status == lock::SUCCESS) {
+            lock::chip_stack_unlock();
+        }
         nvs_handle_t handle;
         err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, &handle);
         if (err != ESP_OK) {
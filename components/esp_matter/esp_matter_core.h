@@ -19,6 +19,8 @@
 #include <app/InteractionModelEngine.h>
 #include <app/util/af-types.h>
 #include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <app/AttributePathParams.h>
 #include <app/CommandPathParams.h>
 #include <app/EventPathParams.h>
@@ -114,6 +116,9 @@ typedef enum status {
  * This API should be called before calling any upstream APIs.
  *
  * @param[in] ticks_to_wait number of ticks to wait for trying to take the lock. Accepted values: 0 to portMAX_DELAY.
+ * With portMAX_DELAY, the task blocks on the lock and lends its priority to the holder. With a finite wait, the task
+ * blocks until `chip_stack_unlock()` releases the lock, the waiter with the highest priority being woken first. While
+ * the lock is held by the Matter thread, whose releases are not signalled, it is checked again on every tick.
  *
  * @return FAILED if the lock was not taken within the specified ticks.
  * @return ALREADY_TAKEN if the lock was already taken by the same task context.
@@ -132,6 +137,50 @@ status_t chip_stack_lock(uint32_t ticks_to_wait);
  */
 esp_err_t chip_stack_unlock();
 
+/** Number of buckets of the lock wait and hold time histograms */
+#define ESP_MATTER_LOCK_HISTOGRAM_BUCKETS 8
+
+/** Upper limits of the histogram buckets in microseconds, the last bucket has no limit */
+constexpr uint32_t histogram_bucket_limits_us[ESP_MATTER_LOCK_HISTOGRAM_BUCKETS] = {
+    100, 1000, 5000, 10000, 50000, 100000, 500000, UINT32_MAX,
+};
+
+/** Stack lock statistics
+ *
+ * The statistics cover the acquisitions through `chip_stack_lock()` which returned `SUCCESS` and the matching
+ * `chip_stack_unlock()` calls. The Matter thread itself takes the lock without these APIs.
+ */
+typedef struct stats {
+    /** Number of successful acquisitions */
+    uint32_t acquisitions;
+    /** Number of calls which could not take the lock in time */
+    uint32_t timeouts;
+    /** Number of acquisitions per wait time bucket */
+    uint32_t wait_histogram[ESP_MATTER_LOCK_HISTOGRAM_BUCKETS];
+    /** Number of acquisitions per hold time bucket */
+    uint32_t hold_histogram[ESP_MATTER_LOCK_HISTOGRAM_BUCKETS];
+    /** Longest wait time in microseconds */
+    uint32_t max_wait_us;
+    /** Longest hold time in microseconds */
+    uint32_t max_hold_us;
+    /** Name of the task which held the lock the longest */
+    char max_hold_task[configMAX_TASK_NAME_LEN];
+    /** Task which currently holds the lock through `chip_stack_lock()`, NULL if none */
+    TaskHandle_t holder;
+} stats_t;
+
+/** Get the stack lock statistics
+ *
+ * @param[out] stats Lock statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_stats(stats_t *stats);
+
+/** Reset the stack lock statistics */
+void reset_stats();
+
 } /* lock */
 
 } /* esp_matter */
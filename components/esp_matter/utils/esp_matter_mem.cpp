@@ -16,6 +16,11 @@
 #include "esp_heap_caps.h"
 #include "esp_matter_mem.h"
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <stdint.h>
+#include <string.h>
+
 IRAM_ATTR void *esp_matter_mem_calloc(size_t n, size_t size)
 {
 #if CONFIG_ESP_MATTER_MEM_ALLOC_MODE_INTERNAL
@@ -46,3 +51,255 @@ IRAM_ATTR void esp_matter_mem_free(void *ptr)
 {
     free(ptr);
 }
+
+#if CONFIG_ESP_MATTER_MEM_NODE_SLAB
+
+#define SLAB_CLASS_COUNT 8
+// The pages are aligned to their size, which is a power of two, so the page of an object is found by masking its
+// address. The classes of the larger objects use larger pages, to have at least SLAB_MIN_OBJECTS_PER_PAGE objects.
+#define SLAB_PAGE_SIZE 512
+#define SLAB_MIN_OBJECTS_PER_PAGE 4
+#define SLAB_MAX_OBJECT_SIZE 256
+#define SLAB_ALIGN 8
+
+typedef struct slab_free_object {
+    struct slab_free_object *next;
+} slab_free_object_t;
+
+// The page header is padded so that the objects following it are aligned
+typedef struct alignas(SLAB_ALIGN) slab_page {
+    struct slab_page *next;
+    uint16_t object_count;
+} slab_page_t;
+
+typedef struct slab_class {
+    uint16_t object_size;
+    uint16_t objects_per_page;
+    uint16_t page_size;
+    slab_page_t *pages;
+    slab_free_object_t *free_list;
+    size_t page_count;
+    size_t object_count;
+    // Objects of this size allocated from the heap because a page could not be allocated
+    size_t heap_object_count;
+} slab_class_t;
+
+static slab_class_t s_slab_classes[SLAB_CLASS_COUNT];
+
+// The data model objects are created and destroyed from the application tasks as well as from the Matter thread
+static SemaphoreHandle_t slab_get_mutex()
+{
+    static StaticSemaphore_t s_slab_mutex_storage;
+    static SemaphoreHandle_t s_slab_mutex = xSemaphoreCreateMutexStatic(&s_slab_mutex_storage);
+    return s_slab_mutex;
+}
+
+static inline size_t slab_object_size(size_t size)
+{
+    return (size + SLAB_ALIGN - 1) & ~(size_t)(SLAB_ALIGN - 1);
+}
+
+static slab_class_t *slab_get_class(size_t object_size, bool create)
+{
+    for (int i = 0; i < SLAB_CLASS_COUNT; i++) {
+        if (s_slab_classes[i].object_size == object_size) {
+            return &s_slab_classes[i];
+        }
+        if (s_slab_classes[i].object_size == 0) {
+            if (!create) {
+                return NULL;
+            }
+            size_t page_size = SLAB_PAGE_SIZE;
+            while ((page_size - sizeof(slab_page_t)) / object_size < SLAB_MIN_OBJECTS_PER_PAGE) {
+                page_size *= 2;
+            }
+            s_slab_classes[i].object_size = object_size;
+            s_slab_classes[i].objects_per_page = (page_size - sizeof(slab_page_t)) / object_size;
+            s_slab_classes[i].page_size = page_size;
+            return &s_slab_classes[i];
+        }
+    }
+    // All the classes are used, the object will be allocated from the heap
+    return NULL;
+}
+
+static inline size_t slab_page_size(const slab_class_t *slab)
+{
+    return slab->page_size;
+}
+
+static void *slab_page_calloc(size_t page_size)
+{
+#if CONFIG_ESP_MATTER_MEM_ALLOC_MODE_INTERNAL
+    return heap_caps_aligned_calloc(page_size, 1, page_size, MALLOC_CAP_INTERNAL|MALLOC_CAP_8BIT);
+#elif CONFIG_ESP_MATTER_MEM_ALLOC_MODE_EXTERNAL
+    return heap_caps_aligned_calloc(page_size, 1, page_size, MALLOC_CAP_SPIRAM|MALLOC_CAP_8BIT);
+#elif CONFIG_ESP_MATTER_MEM_ALLOC_MODE_IRAM_8BIT
+    void *page = heap_caps_aligned_calloc(page_size, 1, page_size, MALLOC_CAP_INTERNAL|MALLOC_CAP_IRAM_8BIT);
+    return page ? page : heap_caps_aligned_calloc(page_size, 1, page_size, MALLOC_CAP_INTERNAL|MALLOC_CAP_8BIT);
+#else
+    return heap_caps_aligned_calloc(page_size, 1, page_size, MALLOC_CAP_DEFAULT);
+#endif
+}
+
+// Get the page which holds an object of a slab page
+static inline slab_page_t *slab_page_of(const slab_class_t *slab, const void *ptr)
+{
+    return (slab_page_t *)((uintptr_t)ptr & ~(uintptr_t)(slab->page_size - 1));
+}
+
+// Get the page which holds the object, NULL if the object was allocated from the heap
+static slab_page_t *slab_get_page(const slab_class_t *slab, const void *ptr)
+{
+    slab_page_t *object_page = slab_page_of(slab, ptr);
+    if (slab->heap_object_count == 0) {
+        // All the objects of this size are in the pages
+        return object_page;
+    }
+    // Some objects of this size were allocated from the heap, their masked address is not a page
+    for (slab_page_t *page = slab->pages; page; page = page->next) {
+        if (page == object_page) {
+            return page;
+        }
+    }
+    return NULL;
+}
+
+static bool slab_add_page(slab_class_t *slab)
+{
+    slab_page_t *page = (slab_page_t *)slab_page_calloc(slab_page_size(slab));
+    if (!page) {
+        return false;
+    }
+    page->next = slab->pages;
+    slab->pages = page;
+    slab->page_count++;
+    uint8_t *objects = (uint8_t *)(page + 1);
+    for (int i = slab->objects_per_page - 1; i >= 0; i--) {
+        slab_free_object_t *object = (slab_free_object_t *)(objects + (size_t)i * slab->object_size);
+        object->next = slab->free_list;
+        slab->free_list = object;
+    }
+    return true;
+}
+
+void *esp_matter_mem_slab_calloc(size_t size)
+{
+    size_t object_size = slab_object_size(size);
+    slab_free_object_t *object = NULL;
+    xSemaphoreTake(slab_get_mutex(), portMAX_DELAY);
+    slab_class_t *slab = object_size <= SLAB_MAX_OBJECT_SIZE ? slab_get_class(object_size, true) : NULL;
+    if (slab && (slab->free_list || slab_add_page(slab))) {
+        object = slab->free_list;
+        slab->free_list = object->next;
+        slab->object_count++;
+        slab_page_of(slab, object)->object_count++;
+    } else if (slab) {
+        // No memory for a new page, the heap might still have a block which fits
+        object = (slab_free_object_t *)esp_matter_mem_calloc(1, size);
+        if (object) {
+            slab->heap_object_count++;
+        }
+        xSemaphoreGive(slab_get_mutex());
+        return object;
+    }
+    xSemaphoreGive(slab_get_mutex());
+    if (!object) {
+        // No slab for this size
+        return esp_matter_mem_calloc(1, size);
+    }
+    memset(object, 0, object_size);
+    return object;
+}
+
+void esp_matter_mem_slab_free(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+    size_t object_size = slab_object_size(size);
+    xSemaphoreTake(slab_get_mutex(), portMAX_DELAY);
+    slab_class_t *slab = object_size <= SLAB_MAX_OBJECT_SIZE ? slab_get_class(object_size, false) : NULL;
+    slab_page_t *page = slab ? slab_get_page(slab, ptr) : NULL;
+    if (page) {
+        slab_free_object_t *object = (slab_free_object_t *)ptr;
+        object->next = slab->free_list;
+        slab->free_list = object;
+        slab->object_count--;
+        page->object_count--;
+    } else if (slab) {
+        slab->heap_object_count--;
+    }
+    xSemaphoreGive(slab_get_mutex());
+    if (!page) {
+        esp_matter_mem_free(ptr);
+    }
+}
+
+void esp_matter_mem_slab_release_empty_pages()
+{
+    xSemaphoreTake(slab_get_mutex(), portMAX_DELAY);
+    for (int i = 0; i < SLAB_CLASS_COUNT && s_slab_classes[i].object_size; i++) {
+        slab_class_t *slab = &s_slab_classes[i];
+        // Drop the free objects of the empty pages from the free list first, it then no longer points into them
+        slab_free_object_t **object = &slab->free_list;
+        while (*object) {
+            slab_page_t *page = slab_page_of(slab, *object);
+            if (page->object_count == 0) {
+                *object = (*object)->next;
+            } else {
+                object = &(*object)->next;
+            }
+        }
+        slab_page_t **page = &slab->pages;
+        while (*page) {
+            if ((*page)->object_count == 0) {
+                slab_page_t *empty_page = *page;
+                *page = empty_page->next;
+                esp_matter_mem_free(empty_page);
+                slab->page_count--;
+            } else {
+                page = &(*page)->next;
+            }
+        }
+    }
+    xSemaphoreGive(slab_get_mutex());
+}
+
+void esp_matter_mem_slab_get_stats(esp_matter_mem_slab_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    xSemaphoreTake(slab_get_mutex(), portMAX_DELAY);
+    for (int i = 0; i < SLAB_CLASS_COUNT && s_slab_classes[i].object_size; i++) {
+        const slab_class_t *slab = &s_slab_classes[i];
+        stats->class_count++;
+        stats->page_count += slab->page_count;
+        stats->page_bytes += slab->page_count * slab_page_size(slab);
+        stats->object_count += slab->object_count;
+        stats->object_bytes += slab->object_count * slab->object_size;
+    }
+    xSemaphoreGive(slab_get_mutex());
+}
+
+#else
+
+void *esp_matter_mem_slab_calloc(size_t size)
+{
+    return esp_matter_mem_calloc(1, size);
+}
+
+void esp_matter_mem_slab_free(void *ptr, size_t size)
+{
+    esp_matter_mem_free(ptr);
+}
+
+void esp_matter_mem_slab_release_empty_pages()
+{
+}
+
+void esp_matter_mem_slab_get_stats(esp_matter_mem_slab_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+#endif // CONFIG_ESP_MATTER_MEM_NODE_SLAB
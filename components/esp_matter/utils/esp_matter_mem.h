@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 /** ESP Matter Memory Allocations
  * @param[in] n number of elements to be allocated
  * @param[in] size size of elements to be allocated
@@ -30,3 +32,53 @@ void esp_matter_mem_free(void *ptr);
  * @param[in] size size to reallocate
  */
 void *esp_matter_mem_realloc(void *ptr, size_t size);
+
+/** ESP Matter slab statistics */
+typedef struct esp_matter_mem_slab_stats {
+    /** Number of size classes in use */
+    size_t class_count;
+    /** Number of slab pages allocated from the heap */
+    size_t page_count;
+    /** Bytes of the slab pages allocated from the heap */
+    size_t page_bytes;
+    /** Number of objects allocated from the slabs */
+    size_t object_count;
+    /** Bytes of the objects allocated from the slabs */
+    size_t object_bytes;
+} esp_matter_mem_slab_stats_t;
+
+/** ESP Matter slab allocation
+ *
+ * Allocate a zero-initialized object from the slab of the objects with the same size. The data model uses this for
+ * the objects which are created in large numbers while building the node, so that they share a few heap blocks
+ * instead of having one heap block each. The slab pages follow the memory allocation strategy of
+ * esp_matter_mem_calloc() and are aligned to their size, so that the page of an object is found from its address
+ * when it is freed. The slabs are protected by a mutex, the functions can be called from any task but
+ * not from an ISR. When the object size has no slab or a new slab page cannot be allocated, the object is allocated
+ * from the heap with esp_matter_mem_calloc(), esp_matter_mem_slab_free() finds out where it came from.
+ *
+ * If CONFIG_ESP_MATTER_MEM_NODE_SLAB is disabled, this is the same as esp_matter_mem_calloc(1, size).
+ *
+ * @param[in] size size of the object to be allocated
+ */
+void *esp_matter_mem_slab_calloc(size_t size);
+
+/** ESP Matter slab free
+ *
+ * @param[in] ptr pointer to the object allocated with esp_matter_mem_slab_calloc().
+ * @param[in] size size of the object, the same as the size passed to esp_matter_mem_slab_calloc().
+ */
+void esp_matter_mem_slab_free(void *ptr, size_t size);
+
+/** ESP Matter slab release
+ *
+ * Return the slab pages which have no object in use to the heap. The pages which still hold objects, such as the
+ * objects of the endpoint templates, are kept. This is called when the whole node is destroyed.
+ */
+void esp_matter_mem_slab_release_empty_pages();
+
+/** ESP Matter slab statistics
+ *
+ * @param[out] stats slab statistics.
+ */
+void esp_matter_mem_slab_get_stats(esp_matter_mem_slab_stats_t *stats);
@@ -279,6 +279,48 @@ static esp_err_t cluster_server_init(endpoint_t *endpoint)
 
 static bridge_device_type_callback_t device_type_callback;
 
+typedef struct device_type_template {
+    uint32_t device_type_id;
+    endpoint_t *template_endpoint;
+    struct device_type_template *next;
+} device_type_template_t;
+
+static device_type_template_t *device_type_template_list = NULL;
+
+static endpoint_t *get_device_type_template(uint32_t device_type_id)
+{
+    for (device_type_template_t *entry = device_type_template_list; entry; entry = entry->next) {
+        if (entry->device_type_id == device_type_id) {
+            return entry->template_endpoint;
+        }
+    }
+    return NULL;
+}
+
+esp_err_t set_device_type_template(uint32_t device_type_id, endpoint_t *template_endpoint)
+{
+    if (!template_endpoint) {
+        ESP_LOGE(TAG, "template_endpoint cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (device_type_template_t *entry = device_type_template_list; entry; entry = entry->next) {
+        if (entry->device_type_id == device_type_id) {
+            entry->template_endpoint = template_endpoint;
+            return ESP_OK;
+        }
+    }
+    device_type_template_t *entry = (device_type_template_t *)esp_matter_mem_calloc(1, sizeof(device_type_template_t));
+    if (!entry) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the device type template");
+        return ESP_ERR_NO_MEM;
+    }
+    entry->device_type_id = device_type_id;
+    entry->template_endpoint = template_endpoint;
+    entry->next = device_type_template_list;
+    device_type_template_list = entry;
+    return ESP_OK;
+}
+
 esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data)
 {
     esp_err_t err;
@@ -287,7 +329,12 @@ esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, voi
         ESP_LOGE(TAG, "bridged_device cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
-    err = device_type_callback(bridged_device->endpoint, device_type_id, priv_data);
+    endpoint_t *template_endpoint = get_device_type_template(device_type_id);
+    if (template_endpoint) {
+        err = add_from_template(bridged_device->endpoint, template_endpoint);
+    } else {
+        err = device_type_callback(bridged_device->endpoint, device_type_id, priv_data);
+    }
     if (err != ESP_OK)
         return err;
 
@@ -49,6 +49,10 @@ device_t *resume_device(esp_matter::node_t *node, uint16_t device_endpoint_id, v
 
 esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data);
 
+// The bridged devices of the device type are created from the template instead of calling the device type callback.
+// The template should outlive the bridged devices created from it.
+esp_err_t set_device_type_template(uint32_t device_type_id, esp_matter::endpoint_t *template_endpoint);
+
 esp_err_t remove_device(device_t *bridged_device);
 
 esp_err_t initialize(esp_matter::node_t *node, bridge_device_type_callback_t device_type_cb);
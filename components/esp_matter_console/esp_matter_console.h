@@ -173,5 +173,14 @@ esp_err_t factoryreset_register_commands();
  */
 esp_err_t attribute_register_commands();
 
+/** Add NVS Commands
+ *
+ * Adds the command for the NVS usage and the NVS writes of the non-volatile attributes.
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure.
+ */
+esp_err_t nvs_register_commands();
+
 } // namespace console
 } // namespace esp_matter
@@ -15,9 +15,18 @@
 #include <esp_heap_caps.h>
 #include <esp_log.h>
 #include <esp_matter_console.h>
+#include <esp_matter_core.h>
+#include <esp_matter_mem.h>
 #include <esp_timer.h>
+#include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+#include <esp_matter_data_model.h>
+#include <esp_matter_data_model_provider.h>
+#endif
+
 namespace esp_matter {
 namespace console {
 
@@ -43,6 +52,222 @@ static esp_err_t up_time_console_handler(int argc, char *argv[])
     return ESP_OK;
 }
 
+static esp_err_t lock_stats_console_handler(int argc, char *argv[])
+{
+    if (argc == 1 && strncmp(argv[0], "reset", sizeof("reset")) == 0) {
+        esp_matter::lock::reset_stats();
+        return ESP_OK;
+    }
+    esp_matter::lock::stats_t stats;
+    esp_matter::lock::get_stats(&stats);
+    printf("Acquisitions\t%" PRIu32 "\tTimeouts\t%" PRIu32 "\n", stats.acquisitions, stats.timeouts);
+    printf("Max wait\t%" PRIu32 " us\n", stats.max_wait_us);
+    printf("Max hold\t%" PRIu32 " us (%s)\n", stats.max_hold_us, stats.max_hold_task);
+    printf("Holder\t\t%s\n", stats.holder ? pcTaskGetName(stats.holder) : "-");
+    printf("\tUp to\t\tWait\t\tHold\n");
+    for (int i = 0; i < ESP_MATTER_LOCK_HISTOGRAM_BUCKETS; ++i) {
+        if (esp_matter::lock::histogram_bucket_limits_us[i] == UINT32_MAX) {
+            printf("\t-\t\t");
+        } else {
+            printf("\t%" PRIu32 " us\t", esp_matter::lock::histogram_bucket_limits_us[i]);
+        }
+        printf("%" PRIu32 "\t\t%" PRIu32 "\n", stats.wait_histogram[i], stats.hold_histogram[i]);
+    }
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+static void print_memory_usage_row(const char *name, uint32_t count, size_t bytes)
+{
+    printf("%s\t%" PRIu32 "\t%u\n", name, count, (unsigned)bytes);
+}
+
+static void print_memory_usage(const node::memory_usage_t &usage)
+{
+    printf("Subsystem\tCount\tBytes\n");
+    print_memory_usage_row("endpoints", usage.endpoint_count, usage.endpoint_bytes);
+    print_memory_usage_row("clusters", usage.cluster_count, usage.cluster_bytes);
+    print_memory_usage_row("attributes", usage.attribute_count, usage.attribute_bytes);
+    print_memory_usage_row("value_buffers", usage.value_buffer_count, usage.value_buffer_bytes);
+    print_memory_usage_row("bounds", usage.bounds_count, usage.bounds_bytes);
+    print_memory_usage_row("commands", usage.command_count, usage.command_bytes);
+    print_memory_usage_row("events", usage.event_count, usage.event_bytes);
+    print_memory_usage_row("indexes", 0, usage.index_bytes);
+    print_memory_usage_row("total", 0, usage.total_bytes);
+}
+
+static esp_err_t data_model_memory_console_handler(int argc, char *argv[])
+{
+    node_t *node = node::get();
+    if (!node) {
+        ESP_LOGE(TAG, "Node is not created");
+        return ESP_ERR_INVALID_STATE;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get the Matter stack lock");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    node::memory_usage_t usage;
+    // The markers let the CI scripts find the report in the device log
+    printf("DM-MEM-START\n");
+    if (argc == 1) {
+        // Breakdown of one endpoint by cluster
+        uint16_t endpoint_id = (uint16_t)strtoul(argv[0], NULL, 0);
+        endpoint_t *endpoint = endpoint::get(node, endpoint_id);
+        if (endpoint && endpoint::get_memory_usage(endpoint, &usage) == ESP_OK) {
+            printf("endpoint: 0x%04" PRIx16 "\n", endpoint_id);
+            print_memory_usage(usage);
+            printf("Cluster\tAttributes\tBytes\n");
+            for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+                if (cluster::get_memory_usage(cluster, &usage) == ESP_OK) {
+                    printf("0x%08" PRIx32 "\t%" PRIu32 "\t%u\n", cluster::get_id(cluster), usage.attribute_count,
+                           (unsigned)usage.total_bytes);
+                }
+            }
+        } else {
+            ESP_LOGE(TAG, "Endpoint 0x%04" PRIx16 " not found", endpoint_id);
+            err = ESP_ERR_NOT_FOUND;
+        }
+    } else if ((err = node::get_memory_usage(&usage)) == ESP_OK) {
+        print_memory_usage(usage);
+        esp_matter_mem_slab_stats_t slab_stats;
+        esp_matter_mem_slab_get_stats(&slab_stats);
+        printf("slab_pages\t%u\t%u\n", (unsigned)slab_stats.page_count, (unsigned)slab_stats.page_bytes);
+        printf("Endpoint\tClusters\tBytes\n");
+        for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+            if (endpoint::get_memory_usage(endpoint, &usage) == ESP_OK) {
+                printf("0x%04" PRIx16 "\t%" PRIu32 "\t%u\n", endpoint::get_id(endpoint), usage.cluster_count,
+                       (unsigned)usage.total_bytes);
+            }
+        }
+    }
+    printf("DM-MEM-END\n");
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+static esp_err_t data_model_counts_console_handler(int argc, char *argv[])
+{
+    node_t *node = node::get();
+    if (!node) {
+        ESP_LOGE(TAG, "Node is not created");
+        return ESP_ERR_INVALID_STATE;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get the Matter stack lock");
+        return ESP_FAIL;
+    }
+    // The counters are kept up to date by the node, nothing is walked but the endpoint list
+    printf("Endpoints\t%" PRIu16 "\n", endpoint::get_count(node));
+    printf("Endpoint\tServer\tClient\n");
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+        uint16_t endpoint_id = endpoint::get_id(endpoint);
+        printf("0x%04" PRIx16 "\t\t%" PRIu32 "\t%" PRIu32 "\n", endpoint_id,
+               endpoint::get_cluster_count(endpoint_id, chip::kInvalidClusterId, CLUSTER_FLAG_SERVER),
+               endpoint::get_cluster_count(endpoint_id, chip::kInvalidClusterId, CLUSTER_FLAG_CLIENT));
+    }
+    esp_err_t err = ESP_OK;
+    uint32_t cluster_id;
+    uint16_t server_count, client_count;
+    printf("Cluster\t\tServer\tClient\n");
+    for (uint16_t i = 0; (err = node::get_cluster_endpoint_counts(i, &cluster_id, &server_count, &client_count)) ==
+         ESP_OK; ++i) {
+        printf("0x%08" PRIx32 "\t%" PRIu16 "\t%" PRIu16 "\n", cluster_id, server_count, client_count);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    if (err == ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "The cluster counts are not available");
+        return err;
+    }
+    return ESP_OK;
+}
+
+typedef struct walk_counts {
+    uint32_t endpoint_count;
+    uint32_t cluster_count;
+    uint32_t attribute_count;
+    uint32_t command_count;
+} walk_counts_t;
+
+// List the metadata of every cluster as the Interaction Model engine does for a wildcard read
+static CHIP_ERROR walk_data_model(data_model::provider &provider, walk_counts_t *counts)
+{
+    memset(counts, 0, sizeof(*counts));
+    chip::ReadOnlyBufferBuilder<data_model::EndpointEntry> endpoint_builder;
+    ReturnErrorOnFailure(provider.Endpoints(endpoint_builder));
+    chip::ReadOnlyBuffer<data_model::EndpointEntry> endpoints = endpoint_builder.TakeBuffer();
+    for (const data_model::EndpointEntry &endpoint : endpoints) {
+        chip::ReadOnlyBufferBuilder<data_model::ServerClusterEntry> cluster_builder;
+        ReturnErrorOnFailure(provider.ServerClusters(endpoint.id, cluster_builder));
+        chip::ReadOnlyBuffer<data_model::ServerClusterEntry> clusters = cluster_builder.TakeBuffer();
+        for (const data_model::ServerClusterEntry &cluster : clusters) {
+            chip::app::ConcreteClusterPath path(endpoint.id, cluster.clusterId);
+            chip::ReadOnlyBufferBuilder<data_model::AttributeEntry> attributes;
+            ReturnErrorOnFailure(provider.Attributes(path, attributes));
+            chip::ReadOnlyBufferBuilder<data_model::AcceptedCommandEntry> accepted_commands;
+            ReturnErrorOnFailure(provider.AcceptedCommands(path, accepted_commands));
+            chip::ReadOnlyBufferBuilder<chip::CommandId> generated_commands;
+            ReturnErrorOnFailure(provider.GeneratedCommands(path, generated_commands));
+            counts->attribute_count += attributes.Size();
+            counts->command_count += accepted_commands.Size() + generated_commands.Size();
+        }
+        counts->cluster_count += clusters.size();
+    }
+    counts->endpoint_count = endpoints.size();
+    return CHIP_NO_ERROR;
+}
+
+static esp_err_t data_model_walk_console_handler(int argc, char *argv[])
+{
+    uint32_t iterations = argc == 1 ? (uint32_t)strtoul(argv[0], NULL, 0) : 10;
+    if (iterations == 0) {
+        ESP_LOGE(TAG, "Iterations must be greater than 0");
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get the Matter stack lock");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    walk_counts_t counts = {};
+    int64_t first_us = 0, min_us = INT64_MAX, max_us = 0, total_us = 0;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        int64_t start_us = esp_timer_get_time();
+        CHIP_ERROR chip_err = walk_data_model(data_model::provider::get_instance(), &counts);
+        int64_t elapsed_us = esp_timer_get_time() - start_us;
+        if (chip_err != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to walk the data model: %" CHIP_ERROR_FORMAT, chip_err.Format());
+            err = ESP_FAIL;
+            break;
+        }
+        first_us = i == 0 ? elapsed_us : first_us;
+        min_us = elapsed_us < min_us ? elapsed_us : min_us;
+        max_us = elapsed_us > max_us ? elapsed_us : max_us;
+        total_us += elapsed_us;
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    if (err == ESP_OK) {
+        printf("Sealed\t\t%s\n", node::is_sealed() ? "yes" : "no");
+        printf("Endpoints\t%" PRIu32 "\tClusters\t%" PRIu32 "\tAttributes\t%" PRIu32 "\tCommands\t%" PRIu32 "\n",
+               counts.endpoint_count, counts.cluster_count, counts.attribute_count, counts.command_count);
+        printf("First walk\t%lld us\n", first_us);
+        printf("Walk\t\tmin %lld us\tavg %lld us\tmax %lld us (%" PRIu32 " walks)\n", min_us,
+               total_us / iterations, max_us, iterations);
+    }
+    return err;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+
 static esp_err_t diagnostics_dispatch(int argc, char **argv)
 {
     if (argc <= 0) {
@@ -71,6 +296,32 @@ esp_err_t diagnostics_register_commands()
             .description = "print the uptime of the device",
             .handler = up_time_console_handler,
         },
+        {
+            .name = "lock-stats",
+            .description = "print the wait and hold times of the Matter stack lock. Usage: matter esp diagnostics "
+                           "lock-stats [reset]",
+            .handler = lock_stats_console_handler,
+        },
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+        {
+            .name = "dm-mem",
+            .description = "print the memory used by the data model. Usage: matter esp diagnostics dm-mem "
+                           "[endpoint_id]",
+            .handler = data_model_memory_console_handler,
+        },
+        {
+            .name = "dm-counts",
+            .description = "print the endpoint and cluster counts kept by the node. Usage: matter esp diagnostics "
+                           "dm-counts",
+            .handler = data_model_counts_console_handler,
+        },
+        {
+            .name = "dm-walk",
+            .description = "time the listing of the endpoints, clusters, attributes and commands done by a wildcard "
+                           "read. Usage: matter esp diagnostics dm-walk [iterations]",
+            .handler = data_model_walk_console_handler,
+        },
+#endif
     };
     diagnostics_console.register_commands(diagnostics_commands, sizeof(diagnostics_commands)/sizeof(command_t));
 
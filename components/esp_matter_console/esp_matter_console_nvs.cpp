@@ -0,0 +1,99 @@
+// Copyright 2025 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_console.h>
+#include <esp_matter_data_model.h>
+#include <inttypes.h>
+#include <string.h>
+
+namespace esp_matter {
+namespace console {
+
+static const char *TAG = "esp_matter_console_nvs";
+static engine nvs_console;
+
+static void print_path_stats(const attribute::nvs_path_stats_t *stats, void *priv_data)
+{
+    printf("0x%04" PRIx16 "\t0x%08" PRIx32 "\t0x%08" PRIx32 "\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\n",
+           stats->endpoint_id, stats->cluster_id, stats->attribute_id, stats->write_count, stats->byte_count,
+           stats->commit_count, stats->window_write_count);
+}
+
+static esp_err_t stats_console_handler(int argc, char *argv[])
+{
+    if (argc == 1 && strncmp(argv[0], "reset", sizeof("reset")) == 0) {
+        return attribute::reset_nvs_stats();
+    }
+    attribute::nvs_partition_stats_t stats;
+    esp_err_t err = attribute::get_nvs_partition_stats(&stats);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to get the NVS statistics");
+        return err;
+    }
+    printf("Entries\t\tused %u\tfree %u\ttotal %u\n", (unsigned)stats.used_entries, (unsigned)stats.free_entries,
+           (unsigned)stats.total_entries);
+    printf("Writes\t\t%" PRIu32 " (%" PRIu32 " untracked)\n", stats.write_count, stats.untracked_write_count);
+    printf("Bytes\t\t%" PRIu32 "\n", stats.byte_count);
+    printf("Commits\t\t%" PRIu32 "\n", stats.commit_count);
+    printf("Entry writes\t%" PRIu32 "\n", stats.entry_write_count);
+    printf("Page erases\t%" PRIu32 " (estimated)\n", stats.estimated_page_erases);
+    printf("Erase cycles\t%" PRIu32 " per page (estimated)\n", stats.estimated_erase_cycles);
+
+    attribute::persistence_stats_t persistence;
+    if (attribute::get_persistence_stats(&persistence) == ESP_OK && persistence.change_count > 0) {
+        printf("Write-behind\tchanges %" PRIu32 "\tavoided %" PRIu32 "\tflushes %" PRIu32 "\tdirty %" PRIu32 "\n",
+               persistence.change_count, persistence.avoided_write_count, persistence.flush_count,
+               persistence.dirty_count);
+    }
+
+    printf("Endpoint\tCluster\t\tAttribute\tWrites\tBytes\tCommits\tLast minute\n");
+    if (attribute::for_each_nvs_path_stats(print_path_stats, NULL) == ESP_ERR_NOT_SUPPORTED) {
+        printf("-\t\t-\t\t-\t\tdisabled, see CONFIG_ESP_MATTER_NVS_WRITE_STATS\n");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t nvs_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        nvs_console.for_each_command(print_description, NULL);
+        return ESP_OK;
+    }
+    return nvs_console.exec_command(argc, argv);
+}
+
+esp_err_t nvs_register_commands()
+{
+    static const command_t command = {
+        .name = "nvs",
+        .description = "NVS commands. Usage matter esp nvs <nvs_command>.",
+        .handler = nvs_dispatch,
+    };
+
+    static const command_t nvs_commands[] = {
+        {
+            .name = "stats",
+            .description = "print the NVS usage and the NVS writes of the non-volatile attributes. Usage: matter esp "
+                           "nvs stats [reset]",
+            .handler = stats_console_handler,
+        },
+    };
+    nvs_console.register_commands(nvs_commands, sizeof(nvs_commands) / sizeof(command_t));
+
+    return add_commands(&command, 1);
+}
+
+} // namespace console
+} // namespace esp_matter
@@ -5,7 +5,7 @@
 import argparse
 import logging
 import glob
-from memory_data_parser import StaticMemoryParser, DynamicMemoryParser
+from memory_data_parser import StaticMemoryParser, DynamicMemoryParser, DataModelMemoryParser
 from gitlab_api import GitLabAPI
 from results_formatter import ResultsFormatter
 
@@ -73,6 +73,30 @@ def process_dynamic_memory(gitlab_api, formatter, chip, example, log_file):
         logging.error(f"Error processing dynamic memory: {str(e)}")
         return False
 
+def format_data_model_memory(formatter, log_file):
+    reports = DataModelMemoryParser.extract_reports(log_file)
+    if not reports:
+        return None
+    # The last report is the latest state of the node
+    subsystems, elements = DataModelMemoryParser.parse_report(reports[-1])
+    return formatter.format_data_model_memory(subsystems, elements)
+
+def process_data_model_memory(gitlab_api, formatter, chip, example, log_file):
+    try:
+        formatted_output = format_data_model_memory(formatter, log_file)
+        if formatted_output is None:
+            logging.info("No data model memory report found in the log file.")
+            return True
+
+        description = gitlab_api.fetch_merge_request_description()
+        description = formatter.update_memory_results_title(description)
+        description = formatter.update_data_model_memory_results_section(description, chip, example, formatted_output)
+        gitlab_api.update_merge_request_description(description)
+        return True
+    except Exception as e:
+        logging.error(f"Error processing data model memory: {str(e)}")
+        return False
+
 def main():
     logging.basicConfig(level=logging.INFO, format="%(asctime)s - %(levelname)s - %(message)s")
 
@@ -82,12 +106,23 @@ def main():
     parser.add_argument("--ref_map_file", help="Reference main branch map file path")
     parser.add_argument("--job_name", help="Job name for the job id search")
     parser.add_argument("--log_file", help="Path to the log file for heap dump analysis")
+    parser.add_argument("--print_only", action="store_true",
+                        help="Print the data model memory report of the log file instead of posting the results, "
+                             "for the logs of host runs")
 
     args = parser.parse_args()
 
-    gitlab_api = GitLabAPI()
     formatter = ResultsFormatter()
 
+    if args.print_only:
+        if not args.log_file:
+            parser.error("--print_only requires --log_file")
+        formatted_output = format_data_model_memory(formatter, args.log_file)
+        print(formatted_output if formatted_output is not None else "No data model memory report found.")
+        return
+
+    gitlab_api = GitLabAPI()
+
     # Process static memory if required parameters are provided
     if all([args.ref_map_file, args.job_name]):
         if process_static_memory(gitlab_api, formatter, args.chip, args.example, args.ref_map_file, args.job_name):
@@ -101,6 +136,10 @@ def main():
             logging.info("Dynamic memory analysis completed successfully")
         else:
             logging.error("Dynamic memory analysis failed")
+        if process_data_model_memory(gitlab_api, formatter, args.chip, args.example, args.log_file):
+            logging.info("Data model memory analysis completed successfully")
+        else:
+            logging.error("Data model memory analysis failed")
 
 if __name__ == "__main__":
     main() 
@@ -44,3 +44,42 @@ class DynamicMemoryParser:
         return parsed_logs
 
 
+class DataModelMemoryParser:
+    """Parse the reports of the `matter esp diagnostics dm-mem` console command"""
+
+    @staticmethod
+    def extract_reports(log_file):
+        reports = []
+        current = None
+        with open(log_file, errors="replace") as f:
+            for line in f:
+                if "DM-MEM-START" in line:
+                    current = []
+                elif "DM-MEM-END" in line:
+                    if current is not None:
+                        reports.append(current)
+                    current = None
+                elif current is not None:
+                    current.append(line.rstrip("\n"))
+        return reports
+
+    @staticmethod
+    def parse_report(lines):
+        """Return the subsystem rows and the endpoint or cluster rows of one report"""
+        subsystems = []
+        elements = []
+        section = None
+        for line in lines:
+            fields = line.split()
+            if not fields:
+                continue
+            if fields[0] in ("Subsystem", "Endpoint", "Cluster"):
+                section = fields[0]
+                continue
+            if fields[0] == "endpoint:" or len(fields) < 3:
+                continue
+            if section == "Subsystem":
+                subsystems.append([fields[-3], int(fields[-2]), int(fields[-1])])
+            elif section is not None:
+                elements.append([fields[-3], int(fields[-2]), int(fields[-1])])
+        return subsystems, elements
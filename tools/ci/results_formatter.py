@@ -74,6 +74,38 @@ class ResultsFormatter:
         headers = ["State", "Current Free Memory", "Largest Free Block", "Min. Ever Free Size"]
         return tabulate(parsed_logs, headers=headers, tablefmt="grid")
 
+    @staticmethod
+    def format_data_model_memory(subsystems, elements):
+        output = tabulate(subsystems, headers=["Subsystem", "Count", "Bytes"], tablefmt="grid")
+        if elements:
+            output += "\n" + tabulate(elements, headers=["Element", "Children", "Bytes"], tablefmt="grid")
+        return output
+
+    @staticmethod
+    def update_data_model_memory_results_section(description, chip_name, example, output):
+        marker_start = f"<!-- START: Data Model Memory Results for {chip_name} -->"
+        marker_end = f"<!-- END: Data Model Memory Results for {chip_name} -->"
+
+        chip_section_content = (
+            f"<details><summary><b>Data Model Memory for target: {chip_name}, example: {example}</b></summary>\n\n"
+            f"```{output}\n```\n"
+            f"</details>\n"
+        )
+
+        chip_section = f"{marker_start}\n{chip_section_content}{marker_end}"
+
+        if marker_start in description and marker_end in description:
+            updated_description = re.sub(
+                rf"{re.escape(marker_start)}.*?{re.escape(marker_end)}",
+                chip_section,
+                description,
+                flags=re.DOTALL,
+            )
+        else:
+            updated_description = description.strip() + "\n\n" + chip_section
+
+        return updated_description
+
     @staticmethod
     def update_cert_test_results_section(description, markdown_content, chunk_id=None):
         # Use chunk-specific markers